@@ -39,6 +39,12 @@
 #include "collision.h"
 #include "render.h"
 #include "event.h"
+#include "bot.h"
+#include "bench.h"
+#include "renderthread.h"
+#include "capture.h"
+#include "softrender.h"
+#include "audio.h"
 
 int main                    (int    argc,
                              char **argv)
@@ -46,11 +52,17 @@ int main                    (int    argc,
     /*** variables ***/
     bool            loop_exit        = false,
                     paused           = false,
-                    show_fps         = false;
+                    show_fps         = false,
+                    capturing        = false,
+                    minimized        = false,
+                    unfocused        = false,
+                    redraw           = true,
+                    idle             = false;
     unsigned        current_timer    = 0,
                     ten_second_timer = 0,
                     half_sec_timer   = 0,
-                    prev_timer       = 0;
+                    prev_timer       = 0,
+                    idle_time        = 0;
     float           frame_time       = 0.f,
                     left_clip        = -1.f, /*screen bounds*/
                     right_clip       = 1.f,
@@ -59,48 +71,76 @@ int main                    (int    argc,
     int             width_real       = 0,
                     height_real      = 0,
                     players_alive    = 0,
+                    aster_free_count = 0,
                     players_blast    = 0; /*workaround to delay reset*/
     char            fps[32]          = {'\0'},
-                    mspf[32]         = {'\0'};
+                    mspf[32]         = {'\0'},
+                    audio_time[32]   = {'\0'},
+                    audio_late[32]   = {'\0'};
     SDL_Window     *win_main;
     SDL_GLContext   win_main_gl;
     st_shared       shared_vars;
-    st_audio        sfx_main[AUDIO_MIX_CHANNELS] = {
-        {true, 96, 0, 0, 0, 1, 1, 1, 1, 0, 0.f, 1.f, 1.f}};
+    st_bench        bench            = {0, 0, 0.0, 0.0, 0.0};
+    st_mixer        mixer;
     player         *plyr;
     asteroid       *aster;
+    int            *aster_free;
+    st_particles    particles        = {0, NULL, NULL, NULL, NULL, NULL};
     options         config           = { /*default config options.*/
-        true, true, true, 96, 1, 1, 8, 3, 5, 1.f,
-        1.f, 1.f, 1.f, 0, {800,600,60}, {0,0,0},
-        {SDL_SCANCODE_W, SDL_SCANCODE_S, SDL_SCANCODE_A, SDL_SCANCODE_D,
-        SDL_SCANCODE_TAB, SDL_SCANCODE_SPACE, SDL_SCANCODE_UP,
-        SDL_SCANCODE_DOWN, SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT,
-        SDL_SCANCODE_RCTRL, SDL_SCANCODE_P, SDL_SCANCODE_GRAVE,
-        SDL_SCANCODE_RIGHTBRACKET, SDL_SCANCODE_LEFTBRACKET,
-        SDL_SCANCODE_ESCAPE}};
+        true, true, true, 96, AUDIO_SAMPLE_RATE, AUDIO_MIX_CHANNELS, 1, 1,
+        RENDERER_VBO, false, 1.f, 8, 3, 2, 5, 1.f, 1.f, 1.f, 1.f, 0,
+        {800,600,60}, {0,0,0},
+        {{{SDL_SCANCODE_W, SDL_SCANCODE_S, SDL_SCANCODE_A, SDL_SCANCODE_D,
+        SDL_SCANCODE_TAB}, {SDL_SCANCODE_UP, SDL_SCANCODE_DOWN,
+        SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT, SDL_SCANCODE_RCTRL},
+        {SDL_SCANCODE_I, SDL_SCANCODE_K, SDL_SCANCODE_J, SDL_SCANCODE_L,
+        SDL_SCANCODE_U}, {SDL_SCANCODE_KP_8, SDL_SCANCODE_KP_5,
+        SDL_SCANCODE_KP_4, SDL_SCANCODE_KP_6, SDL_SCANCODE_KP_0},
+        {0,0,0,0,0}, {0,0,0,0,0}, {0,0,0,0,0}, {0,0,0,0,0}},
+        SDL_SCANCODE_SPACE, SDL_SCANCODE_P, SDL_SCANCODE_GRAVE,
+        SDL_SCANCODE_F12, SDL_SCANCODE_RIGHTBRACKET, SDL_SCANCODE_LEFTBRACKET,
+        SDL_SCANCODE_ESCAPE}, false, 0, NULL, NULL, NULL, {false}};
     /*make pointers to shared vars*/
     shared_vars.aster                = &aster;
+    shared_vars.aster_batch          = NULL;
+    shared_vars.aster_free           = &aster_free;
+    shared_vars.aster_free_count     = &aster_free_count;
     shared_vars.audio_device         = 0;
+    shared_vars.audio_late           = audio_late;
+    shared_vars.audio_time           = audio_time;
     shared_vars.bottom_clip          = &bottom_clip;
+    shared_vars.capture              = NULL;
+    shared_vars.capturing            = &capturing;
     shared_vars.config               = &config;
+    shared_vars.core_context         = false;
+    shared_vars.core_view            = -1;
     shared_vars.current_timer        = &current_timer;
     shared_vars.fps                  = fps;
     shared_vars.frame_time           = &frame_time;
+    shared_vars.gl_lists             = 0;
     shared_vars.height_real          = &height_real;
+    shared_vars.hud                  = NULL;
     shared_vars.left_clip            = &left_clip;
     shared_vars.legacy_context       = false;
     shared_vars.loop_exit            = &loop_exit;
+    shared_vars.minimized            = &minimized;
+    shared_vars.mixer                = &mixer;
     shared_vars.mspf                 = mspf;
+    shared_vars.particle_batch       = NULL;
+    shared_vars.particles            = &particles;
     shared_vars.paused               = &paused;
     shared_vars.players_alive        = &players_alive;
     shared_vars.players_blast        = &players_blast;
     shared_vars.plyr                 = &plyr;
     shared_vars.prev_timer           = &prev_timer;
+    shared_vars.redraw               = &redraw;
+    shared_vars.render               = NULL;
     shared_vars.right_clip           = &right_clip;
-    shared_vars.sfx_main             = sfx_main;
     shared_vars.show_fps             = &show_fps;
+    shared_vars.soft                 = NULL;
     shared_vars.ten_second_timer     = &ten_second_timer;
     shared_vars.top_clip             = &top_clip;
+    shared_vars.unfocused            = &unfocused;
     shared_vars.width_real           = &width_real;
     shared_vars.win_main             = &win_main;
     shared_vars.win_main_gl          = &win_main_gl;
@@ -113,6 +153,13 @@ int main                    (int    argc,
     if(!parse_cmd_args(argc, argv, &config))
         return 1;
 
+    /*-W renders audio offline and exits, no device needed*/
+    if(config.audio_file)
+        return bench_audio(&config) ? 0 : 1;
+
+    /*-C records from the first frame*/
+    capturing = config.capture_file != NULL;
+
     /*init*/
     if(!init_(&shared_vars))
         return 1;
@@ -120,16 +167,37 @@ int main                    (int    argc,
     /*** main loop ***/
     while(!loop_exit)
     {
+        /*** idle ***/
+        /*paused, minimized, or unfocused games sleep until an event
+         *arrives, and only draw when something visible changed*/
+        idle = (paused || minimized || unfocused) && !capturing &&
+               !config.headless && !config.bench_frames && !shared_vars.soft;
+        if(idle)
+        {
+            SDL_WaitEventTimeout(NULL, IDLE_WAIT_MS);
+            /*stop the clocks so nothing jumps on resume*/
+            idle_time         = SDL_GetTicks() - prev_timer;
+            prev_timer       += idle_time;
+            half_sec_timer   += idle_time;
+            ten_second_timer += idle_time;
+        }
+
         /*get last frame time in milliseconds*/
-        current_timer = SDL_GetTicks();
+        if(config.headless || config.bench_frames ||
+                shared_vars.soft) /*simulated clock*/
+            current_timer = prev_timer + 16;
+        else
+            current_timer = SDL_GetTicks();
         frame_time = (float)(current_timer - prev_timer);
         if(current_timer - half_sec_timer > 500)
         {
             half_sec_timer = current_timer;
-            if(show_fps)
+            if(show_fps && !idle)
             {
                 sprintf(mspf, "%.2f MS", frame_time);
                 sprintf(fps,  "%.2f FPS", 1.f/(frame_time*0.001f));
+                if(config.audio_enabled)
+                    audio_timing_text(&mixer, audio_time, audio_late);
             }
         }
         if(frame_time > 250.f) /*yikes*/
@@ -137,24 +205,66 @@ int main                    (int    argc,
         prev_timer = current_timer;
 
         /*** physics ***/
-        if(!paused)
+        if(!paused && !idle)
+        {
+            update_bots(&shared_vars);
             update_physics(&shared_vars);
+        }
 
         /*** event polling ***/
         poll_events(&shared_vars);
 
+        if(config.headless) /*nothing to draw*/
+            continue;
+        if(idle && (!redraw || minimized))
+            continue;
+        redraw = false;
+
+        if(shared_vars.render) /*the render thread draws and swaps*/
+        {
+            publish_snapshot(&shared_vars);
+            /*nothing waits on the display here, don't spin*/
+            if(current_timer == SDL_GetTicks())
+                SDL_Delay(1);
+            continue;
+        }
+
         /*** drawing ***/
+        if(config.bench_frames)
+            bench_frame_start(&bench);
         draw_objects(&shared_vars);
+        if(!shared_vars.soft) /*the soft frame stays in memory*/
+        {
+            capture_frame(&shared_vars);
+            /*swap framebuffer*/
+            SDL_GL_SwapWindow(win_main);
+        }
 
-        /*swap framebuffer*/
-        SDL_GL_SwapWindow(win_main);
+        if(config.bench_frames)
+        {
+            bench_frame_end(&bench, &shared_vars);
+            if(bench.frames >= config.bench_frames)
+                loop_exit = true;
+        }
     }
+    if(config.bench_frames)
+        bench_report(&bench, &shared_vars);
+    if(config.image_file && shared_vars.soft)
+        write_ppm(shared_vars.soft, config.image_file);
 
     /*cleanup*/
     if(config.audio_enabled)
+    {
         SDL_CloseAudioDevice(shared_vars.audio_device);
-    SDL_GL_DeleteContext(win_main_gl);
-    SDL_DestroyWindow(win_main);
+        audio_timing_report(&mixer);
+    }
+    stop_render_thread(&shared_vars);
+    stop_capture(&shared_vars);
+    if(win_main)
+    {
+        SDL_GL_DeleteContext(win_main_gl);
+        SDL_DestroyWindow(win_main);
+    }
     SDL_Quit();
     return 0;
 }
@@ -28,12 +28,23 @@
  *
  *****************************************************************************/
 
-#include <SDL_audio.h>
+#include <SDL.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <math.h>
 #include <string.h>
 #include "global.h"
+#include "shared.h"
+#include "audio.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define AUDIO_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #include <arm_neon.h>
+  #define AUDIO_NEON
+#endif
 
 /*notes in distance from A4 (440Hz)*/
 const int tune_index[2][16] = {
@@ -48,30 +59,176 @@ const int tune_timing[2][16] = {
 /*number of elements in a tune*/
 const unsigned tune_count[2] = {6, 11};
 
-/*** SFX channel ***
+/*recipes of the SOUND_* IDs*/
+const st_sound sound_table[SOUND_COUNT] = {
+    {SFX_TUNE(0),    2, 0, 0, AUDIO_TICK_SAMPLES*100, 0,   1.f, 1.f},
+    {SFX_PLAYER_HIT, 2, 0, 0, AUDIO_TICK_SAMPLES*15,
+                                AUDIO_TICK_SAMPLES*10, 1.f, 0.8f},
+    {SFX_ASTER_HIT,  2, 0, 0, 0, AUDIO_TICK_SAMPLES*16, 1.f, 0.8f}};
+
+/*takes to cache of each SOUND_* ID, more for those using rand()*/
+const int sound_takes[SOUND_COUNT] = {1, SOUND_VARIANTS, SOUND_VARIANTS};
+
+/*a sound may take the channel of one with the same or lower priority*/
+const int sound_priority[SOUND_COUNT] = {2, 1, 0};
+
+/*least time between two starts of a sound, in samples at AUDIO_RATE_MIN;
+ *a burst is spread out by this much, up to AUDIO_DELAY_MAX*/
+const unsigned sound_gap[SOUND_COUNT] = {0, 320, 160}; /*40 ms, 20 ms*/
+
+/*one cycle of each waveform, see init_wavetables()*/
+float wavetable[4][AUDIO_WAVE_SIZE];
+
+void init_mixer(st_mixer  *mix,
+                const int  volume,
+                const int  rate,
+                const int  voices)
+{
+    int   i;
+    float t;
+
+    memset(mix->voice, 0, sizeof(mix->voice));
+    memset(mix->cache, 0, sizeof(mix->cache));
+    memset(mix->variants, 0, sizeof(mix->variants));
+    memset(mix->next_variant, 0, sizeof(mix->next_variant));
+    memset(mix->next_start, 0, sizeof(mix->next_start));
+    memset(&mix->timing, 0, sizeof(mix->timing));
+    mix->timing.freq = SDL_GetPerformanceFrequency();
+    mix->clock       = 0;
+    mix->started     = 0;
+    mix->voice_count = voices < 1 ? 1 :
+                      (voices > AUDIO_VOICE_MAX ? AUDIO_VOICE_MAX : voices);
+    SDL_AtomicSet(&mix->head, 0);
+    SDL_AtomicSet(&mix->tail, 0);
+    SDL_AtomicSet(&mix->volume, volume);
+    mix->rate        = rate < AUDIO_RATE_MIN ? AUDIO_RATE_MIN :
+                      (rate > AUDIO_RATE_MAX ? AUDIO_RATE_MAX : rate);
+    mix->tick_frames = AUDIO_TICK_SAMPLES * mix->rate / AUDIO_RATE_MIN;
+    mixer_format(mix, AUDIO_F32SYS);
+    for(i = 0; i < AUDIO_WAVE_SIZE; i++)
+    {
+        t = (float)i / (float)AUDIO_WAVE_SIZE;
+        /*same shapes and heights as the old per-sample formulas,
+         *centered on 0 so a sound ending doesn't leave a step*/
+        wavetable[0][i] = t < 0.5f ? 1.f : -1.f;               /*square*/
+        wavetable[1][i] = t < 0.5f ? t : t - 1.f;              /*sawtooth*/
+        wavetable[2][i] = t < 0.5f ? 2.f*t - 0.5f : 1.5f - 2.f*t; /*tri*/
+        wavetable[3][i] = 0.5f * sin(2.f * M_PI * t);          /*sine*/
+    }
+}
+
+bool mixer_format(st_mixer *mix, const SDL_AudioFormat format)
+{
+    if(format != AUDIO_F32SYS && format != AUDIO_S16SYS &&
+       format != AUDIO_S8     && format != AUDIO_U8)
+        return false;
+    mix->format      = format;
+    mix->frame_bytes = SDL_AUDIO_BITSIZE(format) / 8;
+    return true;
+}
+
+bool play_sound(st_mixer *mix, const int sound)
+{
+    const int head = SDL_AtomicGet(&mix->head);
+    const int next = (head + 1) % AUDIO_QUEUE;
+
+    if(next == SDL_AtomicGet(&mix->tail)) /*full*/
+        return false;
+    mix->queue[head] = sound;
+    /*publish the slot only once it's written*/
+    SDL_AtomicSet(&mix->head, next);
+    return true;
+}
+
+/* Pick a channel for a sound.
  *
- * An array of st_audio represents different audio channels
- * that get mixed together. Each st_audio contains
- * everything needed to synthesize a sound. If 'silence'
- * is true, only zeros get written to audio. Only the
- * 'volume' from the first st_audio is used to control
- * audio. All variables should be set before playing a sound.
+ *     mix      - mixer passed to audio_fill_buffer()
+ *     priority - priority of the sound, see sound_priority[]
+ *
+ * This is only called internally by start_sounds().
+ *
+ * Returns a free channel if there is one. Otherwise returns the
+ * channel to steal: of those not above 'priority', the oldest
+ * with the lowest priority. Returns -1 if every channel plays
+ * something more important.
+ **/
+int find_voice(const st_mixer *mix, const int priority)
+{
+    int             j;
+    int             steal = -1;
+    const st_voice *v;
+    const st_voice *s = NULL;
+
+    for(j = 0; j < mix->voice_count; j++)
+    {
+        v = &mix->voice[j];
+        if(!v->pcm)
+            return j;
+        if(v->priority > priority)
+            continue;
+        if(!s || v->priority < s->priority ||
+                (v->priority == s->priority && v->order < s->order))
+        {
+            steal = j;
+            s     = v;
+        }
+    }
+    return steal;
+}
+
+/* Start queued sounds.
+ *
+ *     mix - mixer passed to audio_fill_buffer()
+ *
+ * This is only called internally by audio_fill_buffer(), so only
+ * the audio thread ever writes to a channel. Each sound gets a
+ * channel from find_voice(), and is dropped if there isn't one.
+ * Starts of the same sound are kept sound_gap[] apart by delaying
+ * them; one that would wait past AUDIO_DELAY_MAX is dropped.
+ * Sounds with several cached takes play them in turn.
  **/
-typedef struct st_audio {
-    bool        silence;
-    int         volume;   /*between 0 and 127*/
-    unsigned    i;        /*general incrementer*/
-    unsigned    note_nr;  /*increments the note in a tune*/
-    unsigned    sfx_nr;   /*ID of sound to play (see SFX* defines)*/
-    unsigned    attack;   /*ADSR length in samples*/
-    unsigned    decay;
-    unsigned    sustain;
-    unsigned    release;
-    unsigned    waveform; /*1 = square, 2 = saw, 3 = tri, * = sine*/
-    float       freq;     /*starting frequency*/
-    float       amp;      /*starting amplitude*/
-    float       env;      /*starting envelope (0 if attack is >0*/
-} st_audio;
+void start_sounds(st_mixer *mix)
+{
+    int             j,id;
+    int             tail = SDL_AtomicGet(&mix->tail);
+    const int       head = SDL_AtomicGet(&mix->head);
+    const unsigned long max_delay = (unsigned long)AUDIO_DELAY_MAX *
+                                    mix->tick_frames / AUDIO_TICK_SAMPLES;
+    unsigned long   gap, ahead;
+    const st_pcm   *c;
+    st_voice       *v;
+
+    for(; tail != head; tail = (tail + 1) % AUDIO_QUEUE)
+    {
+        id = mix->queue[tail];
+        if(id < 0 || id >= SOUND_COUNT || !mix->variants[id])
+            continue;
+        /*next_start is at most max_delay + gap ahead, anything
+         *larger means it has already passed*/
+        gap   = (unsigned long)sound_gap[id] * mix->tick_frames /
+                AUDIO_TICK_SAMPLES;
+        ahead = mix->next_start[id] - mix->clock;
+        if(ahead > max_delay + gap)
+            ahead = 0;
+        else if(ahead > max_delay)
+            continue;
+        j = find_voice(mix, sound_priority[id]);
+        if(j < 0)
+            continue;
+        c = &mix->cache[id][mix->next_variant[id]];
+        mix->next_variant[id] = (mix->next_variant[id] + 1) %
+                                mix->variants[id];
+        v           = &mix->voice[j];
+        v->pcm      = c->samples;
+        v->left     = c->count;
+        v->delay    = (int)ahead;
+        v->priority = sound_priority[id];
+        v->order    = mix->started++;
+        mix->next_start[id] = mix->clock + ahead + gap;
+    }
+    /*hand the slots back to play_sound()*/
+    SDL_AtomicSet(&mix->tail, tail);
+}
 
 /* Get sample frequency.
  *
@@ -128,88 +285,461 @@ float get_frequency(st_audio *d, const int channel)
     return freq;
 }
 
-void audio_fill_buffer(void *data, uint8_t *buffer, int len)
+/* Apply a linear gain ramp.
+ *
+ *     out   - samples to scale
+ *     start - gain of the first sample
+ *     inc   - gain added per sample
+ *     count - number of samples
+ *
+ * This is only called internally by render_voice(), once per
+ * envelope segment. Sample i is scaled by start + i*inc, four
+ * at a time with SSE2 or NEON, the rest one by one.
+ **/
+void ramp_block(float       *out,
+                const float  start,
+                const float  inc,
+                const int    count)
+{
+    int i = 0;
+#if defined(AUDIO_SSE2)
+    const __m128 a = _mm_set1_ps(start);
+    const __m128 b = _mm_set1_ps(inc);
+    const __m128 k = _mm_set_ps(3.f, 2.f, 1.f, 0.f);
+
+    for(; i < (count & ~3); i += 4)
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(out + i), _mm_add_ps(a,
+                _mm_mul_ps(_mm_add_ps(_mm_set1_ps((float)i), k), b))));
+#elif defined(AUDIO_NEON)
+    const float       first[4] = {0.f, 1.f, 2.f, 3.f};
+    const float32x4_t k        = vld1q_f32(first);
+
+    for(; i < (count & ~3); i += 4)
+        vst1q_f32(out + i, vmulq_f32(vld1q_f32(out + i),
+                vaddq_f32(vdupq_n_f32(start), vmulq_n_f32(
+                        vaddq_f32(vdupq_n_f32((float)i), k), inc))));
+#endif
+    for(; i < count; i++)
+        out[i] *= start + (float)i * inc;
+}
+
+/* Synthesize part of a sound.
+ *
+ *     d     - sound to synthesize, with 'freq' set for this tick
+ *     rate  - sample rate
+ *     out   - samples to write
+ *     count - number of samples
+ *
+ * This is only called internally by cache_sounds(). Fills the
+ * block from the wavetable, then applies the ADSR envelope as
+ * one linear ramp per stage that falls inside the block, so
+ * neither loop branches per sample.
+ *
+ * Returns the number of samples written, fewer than 'count'
+ * if the envelope ended.
+ **/
+int render_voice(st_audio    *d,
+                 const int    rate,
+                 float       *out,
+                 const int    count)
 {
-    int       i,j;
-    int       sample;
-    st_audio *d = (st_audio*)data;
-    uint8_t   final_buffer[AUDIO_CALLBACK_BYTES] = {0};
-    float     tmp_buffer[AUDIO_CALLBACK_BYTES]   = {0.f};
-    float     normalizer = 1.f;
-    float     env_inc    = 1.f;
+    int           i, n;
+    const float  *wave;
+    float         cycles;
+    float         target, inc;
+    unsigned     *stage;
+    unsigned long step;
 
-    /*for each individual mix channel*/
-    for(j = 0; j < AUDIO_MIX_CHANNELS; j++)
+    /*waveform: 1 = square, 2 = saw, 3 = tri, anything else = sine*/
+    if(d->waveform >= 1 && d->waveform <= 3)
+        wave = wavetable[d->waveform - 1];
+    else
+        wave = wavetable[3];
+    /*phase step as a 32-bit fraction of a cycle, whole cycles
+     *dropped (inf/nan from a sound recipe plays the first entry)*/
+    cycles = d->freq / (float)rate;
+    if(!(cycles >= 0.f && cycles <= 1e6f))
+        cycles = 0.f;
+    cycles -= (float)(long)cycles;
+    step    = (unsigned long)(cycles * 4294967296.0) & 0xFFFFFFFFUL;
+    for(i = 0; i < count; i++)
     {
-        if(d[j].silence) /*skip if no sound is set to play*/
-            continue;
-        /*get sample frequency*/
-        d[j].freq = get_frequency(d, j);
-        if(d[j].silence) /*skip if silence requested*/
-            continue;
-        /*envelope increments*/
-        if(d[j].attack > 0)
-            env_inc = (1.f - d[j].env) / (float)d[j].attack;
-        else if(d[j].decay > 0)
-            env_inc = (d[j].env - 0.8f) / (float)d[j].decay;
-        else if(d[j].release > 0)
-            env_inc = d[j].env / (float)d[j].release;
-        /*reset sample-time*/
-        sample = 0;
-        /*compute AUDIO_CALLBACK_BYTES worth of samples*/
-        for(i = 0; i < len; i++, sample++)
+        out[i]   = wave[d->phase >> (32 - AUDIO_WAVE_BITS)];
+        d->phase = (d->phase + step) & 0xFFFFFFFFUL;
+    }
+    /*envelope: attack ramps to 1, decay to 0.8, sustain holds,
+     *release ramps to 0*/
+    for(i = 0; i < count; i += n)
+    {
+        if(d->attack > 0)
         {
-            float time = (float)sample / (float)AUDIO_SAMPLE_RATE;
-            /*add sample to tmp buffer*/
-            if(d[j].waveform == 1)      /*square*/
-            {
-                if(sin(2.0f * M_PI * d[j].freq * time) > 0)
-                    tmp_buffer[i] += (d[j].amp * d[j].env) * 2.f;
-                else
-                    tmp_buffer[i] += 0.f;
-            }
-            else if(d[j].waveform == 2) /*sawtooth*/
-                tmp_buffer[i] += d[j].amp * d[j].env *
-                   (time*d[j].freq - floor(0.5f + time*d[j].freq) + 0.5f);
-            else if(d[j].waveform == 3) /*triangle*/
-                tmp_buffer[i] += d[j].amp * d[j].env *
-                   fabs(2.f * (time*d[j].freq - floor(0.5f + time*d[j].freq)));
-            else                        /*sine*/
-                tmp_buffer[i] += d[j].amp * d[j].env *
-                   0.5f * (sin(2.f * M_PI * d[j].freq * time) + 1.f);
-            /*step through ADSR*/
-            if(d[j].attack > 0)
-            {
-                d[j].env += env_inc;
-                (d[j].attack)--;
-            }
-            else if(d[j].decay > 0)
-            {
-                d[j].env -= env_inc;
-                (d[j].decay)--;
-            }
-            else if(d[j].sustain > 0)
-                (d[j].sustain)--;
-            else if(d[j].release > 0)
+            stage  = &d->attack;
+            target = 1.f;
+        }
+        else if(d->decay > 0)
+        {
+            stage  = &d->decay;
+            target = 0.8f;
+        }
+        else if(d->sustain > 0)
+        {
+            stage  = &d->sustain;
+            target = d->env;
+        }
+        else if(d->release > 0)
+        {
+            stage  = &d->release;
+            target = 0.f;
+        }
+        else /*end of ADSR*/
+        {
+            d->silence = true;
+            break;
+        }
+        n   = *stage < (unsigned)(count - i) ? (int)*stage : count - i;
+        inc = (target - d->env) / (float)*stage;
+        ramp_block(out + i, d->amp * d->env, d->amp * inc, n);
+        *stage -= n;
+        d->env  = *stage ? d->env + inc * (float)n : target;
+    }
+    return i;
+}
+
+bool cache_sounds(st_mixer *mix)
+{
+    int             id,k,n;
+    int             max;
+    st_audio        d;
+    st_pcm         *c;
+    const st_sound *s;
+
+    for(id = 0; id < SOUND_COUNT; id++)
+    {
+        s = &sound_table[id];
+        /*longest the envelope allows, the recipe may end it sooner*/
+        max = (s->attack + s->decay + s->sustain + s->release) *
+              mix->tick_frames / AUDIO_TICK_SAMPLES + mix->tick_frames;
+        for(k = 0; k < sound_takes[id]; k++)
+        {
+            c = &mix->cache[id][k];
+            c->samples = (float*) malloc(sizeof(float) * max);
+            if(!c->samples)
             {
-                d[j].env -= env_inc;
-                (d[j].release)--;
+                fprintf(stderr, "Could not allocate the sound cache.\n");
+                return false;
             }
-            else /*end of ADSR*/
+            d.silence  = false;
+            d.sfx_nr   = s->sfx_nr;
+            d.note_nr  = 0;
+            d.i        = 0;
+            d.waveform = s->waveform;
+            d.amp      = s->amp;
+            d.freq     = 1.f;
+            d.env      = s->env;
+            d.phase    = 0;
+            /*lengths are given at AUDIO_RATE_MIN*/
+            d.attack   = s->attack  * mix->tick_frames / AUDIO_TICK_SAMPLES;
+            d.decay    = s->decay   * mix->tick_frames / AUDIO_TICK_SAMPLES;
+            d.sustain  = s->sustain * mix->tick_frames / AUDIO_TICK_SAMPLES;
+            d.release  = s->release * mix->tick_frames / AUDIO_TICK_SAMPLES;
+            /*the recipe steps once per tick, as it did when played live*/
+            c->count = 0;
+            while(c->count + mix->tick_frames <= max)
             {
-                d[j].silence = true;
-                break;
+                d.freq = get_frequency(&d, 0);
+                if(d.silence)
+                    break;
+                n = render_voice(&d, mix->rate, c->samples + c->count,
+                                 mix->tick_frames);
+                c->count += n;
+                if(n < mix->tick_frames)
+                    break;
             }
         }
+        mix->variants[id] = sound_takes[id];
+    }
+    return true;
+}
+
+/* Add one channel to the mix.
+ *
+ *     out   - samples to add to
+ *     in    - samples of the channel
+ *     count - number of samples
+ *
+ * This is only called internally by audio_fill_buffer(). Four
+ * samples at a time with SSE2 or NEON, the rest one by one.
+ **/
+void mix_block(float *out, const float *in, const int count)
+{
+    int i = 0;
+
+#if defined(AUDIO_SSE2)
+    for(; i < (count & ~3); i += 4)
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i),
+                                          _mm_loadu_ps(in + i)));
+#elif defined(AUDIO_NEON)
+    for(; i < (count & ~3); i += 4)
+        vst1q_f32(out + i, vaddq_f32(vld1q_f32(out + i), vld1q_f32(in + i)));
+#endif
+    for(; i < count; i++)
+        out[i] += in[i];
+}
+
+/* Convert the mix to the device format.
+ *
+ *     mix    - mixer holding the mixed samples in 'out'
+ *     gain   - volume applied to every sample
+ *     buffer - device buffer to write
+ *     count  - number of samples
+ *
+ * This is only called internally by audio_fill_buffer(). Samples
+ * are scaled and clamped to [-1,1] in place, then written out as
+ * mix->format. Scaling and 16-bit conversion use SSE2 or NEON.
+ **/
+void convert_block(st_mixer    *mix,
+                   const float  gain,
+                   uint8_t     *buffer,
+                   const int    count)
+{
+    int    i = 0;
+    float *f = mix->out;
+#if defined(AUDIO_SSE2)
+    const __m128 g  = _mm_set1_ps(gain);
+    const __m128 lo = _mm_set1_ps(-1.f);
+    const __m128 hi = _mm_set1_ps(1.f);
+    const __m128 s  = _mm_set1_ps(32767.f);
+
+    for(; i < (count & ~3); i += 4)
+        _mm_storeu_ps(f + i, _mm_min_ps(_mm_max_ps(
+                _mm_mul_ps(_mm_loadu_ps(f + i), g), lo), hi));
+#elif defined(AUDIO_NEON)
+    const float32x4_t lo = vdupq_n_f32(-1.f);
+    const float32x4_t hi = vdupq_n_f32(1.f);
+
+    for(; i < (count & ~3); i += 4)
+        vst1q_f32(f + i, vminq_f32(vmaxq_f32(
+                vmulq_n_f32(vld1q_f32(f + i), gain), lo), hi));
+#endif
+    for(; i < count; i++)
+    {
+        f[i] *= gain;
+        f[i]  = f[i] < -1.f ? -1.f : (f[i] > 1.f ? 1.f : f[i]);
+    }
+    switch(mix->format)
+    {
+        case AUDIO_F32SYS:
+            memcpy(buffer, f, sizeof(float)*count);
+            break;
+        case AUDIO_S16SYS:
+            i = 0;
+#if defined(AUDIO_SSE2)
+            for(; i < (count & ~7); i += 8)
+                _mm_storeu_si128((__m128i*)(mix->pcm + i), _mm_packs_epi32(
+                        _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(f + i), s)),
+                        _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(f+i+4), s))));
+#elif defined(AUDIO_NEON)
+            for(; i < (count & ~3); i += 4)
+                vst1_s16(mix->pcm + i, vqmovn_s32(vcvtq_s32_f32(
+                        vmulq_n_f32(vld1q_f32(f + i), 32767.f))));
+#endif
+            for(; i < count; i++)
+                mix->pcm[i] = (short)(f[i] * 32767.f);
+            memcpy(buffer, mix->pcm, sizeof(short)*count);
+            break;
+        case AUDIO_S8:
+            for(i = 0; i < count; i++)
+                buffer[i] = (uint8_t)(int)(f[i] * 127.f);
+            break;
+        default: /*AUDIO_U8*/
+            for(i = 0; i < count; i++)
+                buffer[i] = (uint8_t)(int)(f[i] * 127.f + 128.f);
+            break;
+    }
+}
+
+/* Record the timing of one callback.
+ *
+ *     t      - timing of the mixer
+ *     start  - performance counter when the callback started
+ *     frames - samples the callback wrote
+ *     rate   - output sample rate
+ *
+ * This is only called internally by audio_fill_buffer(), at its
+ * end. Only the audio thread writes 'timing', so each count is
+ * a plain atomic read and set, with no compare-and-swap loop.
+ **/
+void time_callback(st_audio_timing *t,
+                   const Uint64     start,
+                   const int        frames,
+                   const int        rate)
+{
+    int          b;
+    const double us     = 1000000.0 / (double)t->freq;
+    const int    budget = (int)(1000000.0 * frames / rate);
+    const double run    = (double)(SDL_GetPerformanceCounter() - start) * us;
+    double       gap;
+
+    for(b = 0; b < AUDIO_HIST_BINS - 1 && run >= (double)(1 << b); b++);
+    SDL_AtomicAdd(&t->hist[b], 1);
+    SDL_AtomicAdd(&t->calls, 1);
+    SDL_AtomicSet(&t->budget, budget);
+    if(run > SDL_AtomicGet(&t->worst))
+        SDL_AtomicSet(&t->worst, (int)run);
+    if(run > (double)budget)
+        SDL_AtomicAdd(&t->over, 1);
+    if(t->last && budget > 0)
+    {
+        gap = (double)(start - t->last) * us;
+        if(gap > 1e9) /*an hour, keeps the casts in range*/
+            gap = 1e9;
+        if(gap > SDL_AtomicGet(&t->gap))
+            SDL_AtomicSet(&t->gap, (int)gap);
+        if(gap > 1.5 * budget)
+        {
+            SDL_AtomicAdd(&t->late, 1);
+            SDL_AtomicAdd(&t->missed, (int)(gap / budget) - 1);
+        }
+    }
+    t->last = start;
+}
+
+void audio_fill_buffer(void *data, uint8_t *buffer, int len)
+{
+    int         j;
+    int         n, count;
+    st_mixer   *mix    = (st_mixer*)data;
+    st_voice   *v      = mix->voice;
+    int         frames = len / mix->frame_bytes;
+    /*about as loud as the old 8-bit mix, with the same headroom
+     *per channel when the pool is larger*/
+    const float gain   = SDL_AtomicGet(&mix->volume) / (64.f *
+                         (mix->voice_count > AUDIO_MIX_CHANNELS ?
+                          mix->voice_count : AUDIO_MIX_CHANNELS));
+    int         skip;
+    const Uint64 start = SDL_GetPerformanceCounter();
+
+    start_sounds(mix);
+    while(frames > 0)
+    {
+        n = frames < AUDIO_TICK_MAX ? frames : AUDIO_TICK_MAX;
+        memset(mix->out, 0, sizeof(float)*n);
+        /*for each individual mix channel*/
+        for(j = 0; j < mix->voice_count; j++)
+        {
+            if(!v[j].pcm) /*skip if no sound is set to play*/
+                continue;
+            /*a delayed sound starts part way into the block*/
+            skip        = v[j].delay < n ? v[j].delay : n;
+            v[j].delay -= skip;
+            count       = n - skip < v[j].left ? n - skip : v[j].left;
+            mix_block(mix->out + skip, v[j].pcm, count);
+            v[j].pcm  += count;
+            v[j].left -= count;
+            if(!v[j].left)
+                v[j].pcm = NULL;
+        }
+        convert_block(mix, gain, buffer, n);
+        buffer     += n * mix->frame_bytes;
+        frames     -= n;
+        mix->clock += n;
     }
-    /*normalize to [0,255] (assume each sound is [0,1])*/
-    normalizer = 255.f/AUDIO_MIX_CHANNELS;
-    for(i = 0; i < len; i++)
+    time_callback(&mix->timing, start, len / mix->frame_bytes, mix->rate);
+}
+
+/* Get a percentile of the callback times.
+ *
+ *     t   - timing of the mixer
+ *     pct - between 0 and 100
+ *
+ * Returns the upper edge of the histogram bin holding the
+ * percentile, or the worst time if that is lower, in
+ * microseconds. Returns 0 if nothing was timed.
+ **/
+int timing_percentile(st_audio_timing *t, const int pct)
+{
+    int  b, worst;
+    long seen = 0;
+    const long want = ((long)SDL_AtomicGet(&t->calls) * pct + 99) / 100;
+
+    if(!want)
+        return 0;
+    for(b = 0; b < AUDIO_HIST_BINS - 1; b++)
     {
-        tmp_buffer[i] *= normalizer;
-        final_buffer[i] = (uint8_t)tmp_buffer[i];
+        seen += SDL_AtomicGet(&t->hist[b]);
+        if(seen >= want)
+            break;
     }
-    memset(buffer, 0, len);
-    SDL_MixAudioFormat(buffer, final_buffer, AUDIO_S8, len, d[0].volume);
+    worst = SDL_AtomicGet(&t->worst);
+    return worst < 1 << b ? worst : 1 << b;
 }
 
+/* Format a count for the overlay.
+ *
+ *     str   - gets the label and the count, at most 10 characters
+ *     label - up to 4 characters
+ *     value - count to show
+ *
+ * This is only called internally by audio_timing_text(). Counts
+ * past 999, or that wrapped around, show as MANY, since the HUD
+ * font only has letters, digits and '.'.
+ **/
+void format_count(char *str, const char *label, const int value)
+{
+    if(value < 0 || value > 999)
+        sprintf(str, "%.4s MANY", label);
+    else
+        sprintf(str, "%.4s %d", label, value);
+}
+
+void audio_timing_text(st_mixer *mix, char *time, char *late)
+{
+    char             count[3][10];
+    double           p99, worst;
+    st_audio_timing *t = &mix->timing;
+
+    /*at most 999.99 each, so the line stays under TEXT_MAX_CHARS*/
+    p99   = timing_percentile(t, 99) * 0.001;
+    worst = SDL_AtomicGet(&t->worst) * 0.001;
+    sprintf(time, "AUDIO P99 %.2f MAX %.2f MS",
+            p99 < 999.99 ? p99 : 999.99, worst < 999.99 ? worst : 999.99);
+    format_count(count[0], "LATE", SDL_AtomicGet(&t->late));
+    format_count(count[1], "MISS", SDL_AtomicGet(&t->missed));
+    format_count(count[2], "OVER", SDL_AtomicGet(&t->over));
+    sprintf(late, "%s %s %s", count[0], count[1], count[2]);
+}
+
+void audio_timing_report(st_mixer *mix)
+{
+    int              b, count;
+    st_audio_timing *t     = &mix->timing;
+    const int        calls = SDL_AtomicGet(&t->calls);
+
+    if(!calls)
+        return;
+    printf("\nAudio callback: %d calls, %.3f ms budget per buffer\n",
+            calls, SDL_AtomicGet(&t->budget) * 0.001);
+    printf("           run time 50%%: %.3f ms or less\n",
+            timing_percentile(t, 50) * 0.001);
+    printf("                    99%%: %.3f ms or less\n",
+            timing_percentile(t, 99) * 0.001);
+    printf("                    max: %.3f ms\n",
+            SDL_AtomicGet(&t->worst) * 0.001);
+    printf("           over budget: %d\n",
+            SDL_AtomicGet(&t->over));
+    printf("           longest gap: %.3f ms\n",
+            SDL_AtomicGet(&t->gap) * 0.001);
+    printf("           late: %d, buffers missed: %d\n",
+            SDL_AtomicGet(&t->late),
+            SDL_AtomicGet(&t->missed));
+    printf("           run time histogram:\n");
+    for(b = 0; b < AUDIO_HIST_BINS; b++)
+    {
+        if(!(count = SDL_AtomicGet(&t->hist[b])))
+            continue;
+        if(b == AUDIO_HIST_BINS - 1)
+            printf("           %8d us or more %9d\n", 1 << (b - 1), count);
+        else
+            printf("           under %6d us %9d\n", 1 << b, count);
+    }
+}
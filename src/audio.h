@@ -32,44 +32,121 @@
 #define AUDIO_H
 
 #include <stdint.h>
+#include "shared.h"
 
 /* Audio stream callback.
  *
- *     data - st_audio array assigned to an audio spec
+ *     data - st_mixer assigned to an audio spec
  *     buffer - audio buffer to be filled
  *     len - size of buffer in bytes
  *
- * This is called automatically by SDL to fill
- * AUDIO_CALLBACK_BYTES worth of data to the audio buffer.
- *
- * Inside is a rough synthesizer that handles ADSR enveloping
- * and different waveforms (sine, square, saw, triangle).
- * Each "mix channel" is added together and normalized, then
- * mixed through SDL_MixAudioFormat for volume control.
- *
- * To play a sound, find a free "mix channel"
- *
- *     for(i=0; i<AUDIO_MIX_CHANNELS; i++)
- *         if(st_audio[i].silence)
- *
- * then set the elements of st_audio[i] to the sound to play
- *
- *     st_audio[i].sfx_nr   = <sfx to play>
- *     st_audio[i].note_nr  = 0
- *     st_audio[i].i        = 0
- *     st_audio[i].waveform = <waveform to use>
- *     st_audio[i].freq     = 0
- *     st_audio[i].amp      = 1
- *     st_audio[i].env      = <0 if attack != 0>
- *     st_audio[i].attack   = <attack duration>
- *     st_audio[i].decay    = <decay duration>
- *     st_audio[i].sustain  = <sustain duration>
- *     st_audio[i].release  = <release duration>
- *     st_audio[i].silence  = false
+ * This is called automatically by SDL to fill the audio buffer
+ * with mono samples at the mixer's rate and format.
+ *
+ * Sounds waiting in the mixer's queue are started first. Each
+ * "mix channel" then adds the next samples of its cached sound,
+ * and the sum is scaled by the volume and converted to the
+ * device format. The scale leaves room for every channel of the
+ * pool, and at least AUDIO_MIX_CHANNELS, to play at once.
+ * Nothing is synthesized here, so the cost only depends on the
+ * number of channels playing. Each call is timed into the
+ * mixer's 'timing', see audio_timing_report().
+ *
+ * Sounds are played with play_sound(), never by writing
+ * to the channels directly.
  **/
 void audio_fill_buffer      (void    *data,
                              uint8_t *buffer,
                              int      len);
 
+/* Set up the mixer.
+ *
+ *     mix    - mixer to clear
+ *     volume - between 0 and 127
+ *     rate   - output sample rate, clamped to AUDIO_RATE_MIN and
+ *              AUDIO_RATE_MAX
+ *     voices - channels that can play at once, clamped to 1 and
+ *              AUDIO_VOICE_MAX
+ *
+ * Silences every channel, empties the sound queue and the sound
+ * cache, and builds the waveform tables. The output format
+ * starts as AUDIO_F32SYS.
+ **/
+void init_mixer             (st_mixer  *mix,
+                             const int  volume,
+                             const int  rate,
+                             const int  voices);
+
+/* Set the output format.
+ *
+ *     mix    - mixer writing the samples
+ *     format - sample format the device opened with
+ *
+ * AUDIO_F32SYS, AUDIO_S16SYS, AUDIO_S8 and AUDIO_U8 are written
+ * directly. For anything else, reopen the device with the format
+ * SDL should convert from.
+ *
+ * Returns false if the format isn't supported, leaving the mixer
+ * unchanged.
+ **/
+bool mixer_format           (st_mixer             *mix,
+                             const SDL_AudioFormat format);
+
+/* Fill the sound cache.
+ *
+ *     mix - mixer set up by init_mixer()
+ *
+ * Synthesizes every SOUND_* at the mixer rate, stepping each
+ * recipe (tune notes, random hit noise) once per AUDIO_TICK_SAMPLES
+ * samples at AUDIO_RATE_MIN (32 ms). Sounds that use rand() get
+ * several takes. Call before opening the audio device.
+ *
+ * Returns false if the cache can't be allocated.
+ **/
+bool cache_sounds           (st_mixer  *mix);
+
+/* Queue a sound.
+ *
+ *     mix   - mixer the sound is sent to
+ *     sound - SOUND_* ID to start
+ *
+ * Only call this from one thread (the game thread). The audio
+ * callback starts the sound at the start of its next buffer, on
+ * a free channel or else on the oldest channel playing a sound
+ * of the same or lower priority. It is dropped if every channel
+ * plays something more important. Repeats of one sound are
+ * spread out by a minimum gap, and dropped if the gap would
+ * delay them too long, so a burst of hits can't flood the mix.
+ *
+ * Returns false if the queue is full and the sound was dropped.
+ **/
+bool play_sound             (st_mixer  *mix,
+                             const int  sound);
+
+/* Describe the audio callback timing for the debug overlay.
+ *
+ *     mix  - mixer of the running device
+ *     time - gets the 99th percentile and worst callback run time
+ *     late - gets the late, missed and over budget counts
+ *
+ * Both strings need room for TEXT_MAX_CHARS, and are never longer.
+ * Times past 999.99 ms show as 999.99, and counts past 999 as
+ * MANY. Safe to call from any thread while the device plays.
+ **/
+void audio_timing_text      (st_mixer *mix,
+                             char     *time,
+                             char     *late);
+
+/* Print the audio callback timing.
+ *
+ *     mix - mixer of the device
+ *
+ * Prints the run time percentiles and histogram, the buffers that
+ * ran over budget, and the late and missed callbacks since
+ * init_mixer(). Prints nothing if the callback never ran. Call
+ * after closing the device.
+ **/
+void audio_timing_report    (st_mixer *mix);
+
 #endif /*AUDIO_H*/
 
@@ -0,0 +1,220 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifdef _WIN32
+  #include <Windows.h>
+#endif
+#ifdef __APPLE__
+  #include <Carbon/Carbon.h>
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+#include <SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include "global.h"
+#include "shared.h"
+#include "audio.h"
+
+void bench_frame_start(st_bench *bench)
+{
+    bench->start = SDL_GetPerformanceCounter();
+}
+
+void bench_frame_end(st_bench *bench, st_shared *frame)
+{
+    Uint64 freq;
+    double ms;
+
+    if(!frame->soft)
+        glFinish();
+    freq = SDL_GetPerformanceFrequency();
+    ms   = (double)(SDL_GetPerformanceCounter() - bench->start) * 1000.0 /
+           (double)freq;
+    if(!bench->frames || ms < bench->min)
+        bench->min = ms;
+    if(!bench->frames || ms > bench->max)
+        bench->max = ms;
+    bench->total += ms;
+    bench->frames++;
+}
+
+void bench_report(const st_bench *bench, st_shared *report)
+{
+    double avg = 0.0;
+
+    if(bench->frames)
+        avg = bench->total / bench->frames;
+    printf("\nBenchmark: %u frames at %dx%d, ", bench->frames,
+            *report->width_real, *report->height_real);
+    if(report->soft)
+    {
+        printf("software renderer\n");
+        printf("           no GL, one byte per pixel\n");
+    }
+    else if(report->core_context)
+        printf("OpenGL 3.3 core renderer\n");
+    else if(report->legacy_context)
+        printf("OpenGL 1.1 legacy renderer\n");
+    else
+        printf("OpenGL 1.5 VBO renderer\n");
+    if(!report->soft)
+        printf("           GL renderer: %s\n",
+                (const char *)glGetString(GL_RENDERER));
+    if(!report->soft && report->scale.enabled)
+        printf("           render scale: %.2f%s (%dx%d)\n",
+                report->scale.factor, report->scale.adjust ? " auto" : "",
+                report->scale.width, report->scale.height);
+    printf("           frame time min: %.3f ms\n", bench->min);
+    printf("                      avg: %.3f ms\n", avg);
+    printf("                      max: %.3f ms\n", bench->max);
+    if(avg > 0.0)
+        printf("           average fps: %.1f\n", 1000.0 / avg);
+}
+
+/* Write a little-endian number.
+ *
+ *     file  - file to write
+ *     value - number to write
+ *     bytes - number of bytes, least significant first
+ **/
+void write_le(FILE *file, const unsigned long value, const int bytes)
+{
+    int i;
+
+    for(i = 0; i < bytes; i++)
+        fputc((int)((value >> (i*8)) & 0xFF), file);
+}
+
+/* Write a WAV header.
+ *
+ *     file    - file to write, at its start
+ *     rate    - sample rate
+ *     samples - number of mono 16-bit samples that follow
+ **/
+void write_wav_header(FILE *file, const int rate, const unsigned long samples)
+{
+    fwrite("RIFF", 1, 4, file);
+    write_le(file, 36 + samples*2, 4);
+    fwrite("WAVEfmt ", 1, 8, file);
+    write_le(file, 16, 4);          /*format chunk size*/
+    write_le(file, 1, 2);           /*PCM*/
+    write_le(file, 1, 2);           /*mono*/
+    write_le(file, rate, 4);
+    write_le(file, rate*2, 4);      /*bytes per second*/
+    write_le(file, 2, 2);           /*bytes per sample*/
+    write_le(file, 16, 2);          /*bits per sample*/
+    fwrite("data", 1, 4, file);
+    write_le(file, samples*2, 4);
+}
+
+bool bench_audio(const options *config)
+{
+    int           i,j,k;
+    int           busy;
+    int           next_sound = 0;
+    bool          ok = true;
+    short         buffer[AUDIO_TICK_SAMPLES];
+    double        ms, total, worst;
+    double        first_avg = 0.0;
+    double        budget;
+    unsigned long samples = 0;
+    Uint64        start;
+    const Uint64  freq = SDL_GetPerformanceFrequency();
+    int           calls;
+    FILE         *file;
+    st_mixer      mix;
+
+    init_mixer(&mix, config->audio_volume, config->audio_rate,
+               config->audio_voices);
+    if(!cache_sounds(&mix) || !mixer_format(&mix, AUDIO_S16SYS))
+        return false;
+    if(!(file = fopen(config->audio_file, "wb")))
+    {
+        perror("fopen audio file");
+        return false;
+    }
+    write_wav_header(file, mix.rate, 0); /*sizes filled in at the end*/
+    calls  = AUDIO_BENCH_SECONDS * mix.rate / AUDIO_TICK_SAMPLES;
+    budget = 1000.0 * AUDIO_TICK_SAMPLES / mix.rate;
+    printf("\nAudio benchmark: %d s at %d Hz, %d-sample buffers\n",
+            AUDIO_BENCH_SECONDS, mix.rate, AUDIO_TICK_SAMPLES);
+    printf("           budget per buffer: %.3f ms\n", budget);
+    printf("           channels  samples/s    avg ms  worst ms\n");
+    for(k = 1; k <= mix.voice_count; k++)
+    {
+        memset(mix.voice, 0, sizeof(mix.voice));
+        total = worst = 0.0;
+        for(i = 0; i < calls; i++)
+        {
+            /*keep 'k' channels mixing, cycling through the sounds;
+             *at most one of each per buffer, with its gap cleared,
+             *so none is delayed or dropped by the rate limit*/
+            for(j = 0, busy = 0; j < mix.voice_count; j++)
+                busy += mix.voice[j].pcm && !mix.voice[j].delay;
+            for(j = 0; busy < k && j < SOUND_COUNT; busy++, j++, next_sound++)
+            {
+                mix.next_start[next_sound % SOUND_COUNT] = mix.clock;
+                play_sound(&mix, next_sound % SOUND_COUNT);
+            }
+            start = SDL_GetPerformanceCounter();
+            audio_fill_buffer(&mix, (uint8_t*)buffer, sizeof(buffer));
+            ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 /
+                 (double)freq;
+            total += ms;
+            if(ms > worst)
+                worst = ms;
+            if(k == mix.voice_count)
+            {
+                for(j = 0; j < AUDIO_TICK_SAMPLES; j++)
+                    write_le(file, (unsigned short)buffer[j], 2);
+                samples += AUDIO_TICK_SAMPLES;
+            }
+        }
+        if(k == 1)
+            first_avg = total / calls;
+        printf("           %8d %10.0f %9.4f %9.4f%s\n", k,
+                total > 0.0 ? 1000.0 * calls * AUDIO_TICK_SAMPLES / total
+                            : 0.0,
+                total / calls, worst, worst > budget ? "  over budget" : "");
+        if(worst > budget)
+            ok = false;
+        if(k == mix.voice_count && k > 1)
+            printf("           cost per extra channel: %.4f ms\n",
+                    (total / calls - first_avg) / (mix.voice_count - 1));
+    }
+    rewind(file);
+    write_wav_header(file, mix.rate, samples);
+    fclose(file);
+    printf("           wrote %lu samples to %s\n", samples,
+            config->audio_file);
+    return ok;
+}
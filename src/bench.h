@@ -0,0 +1,86 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "shared.h"
+
+/* Start timing a benchmark frame.
+ *
+ *     bench - benchmark state
+ *
+ * Should be called right before draw_objects().
+ **/
+void bench_frame_start      (st_bench *bench);
+
+/* Finish timing a benchmark frame.
+ *
+ *     bench - benchmark state
+ *     frame - struct containing variables required for drawing
+ *
+ * Waits for the GPU to finish the frame with glFinish() so the
+ * time covers the actual rendering, not just queuing commands.
+ * The software renderer is already done when draw_objects() returns.
+ * Should be called after the buffer swap.
+ **/
+void bench_frame_end        (st_bench  *bench,
+                             st_shared *frame);
+
+/* Print benchmark results.
+ *
+ *     bench  - benchmark state
+ *     report - struct containing variables required for the report
+ *
+ * Prints the renderer, resolution, and the minimum, average, and
+ * maximum frame times to stdout.
+ **/
+void bench_report           (const st_bench *bench,
+                             st_shared      *report);
+
+/* Run the audio benchmark.
+ *
+ *     config - sample rate, volume, and the WAV file to write
+ *
+ * Drives audio_fill_buffer() directly, without an audio device,
+ * in AUDIO_TICK_SAMPLES buffers of AUDIO_S16SYS. Each pass keeps
+ * 1 to options.audio_voices channels busy with the cached sounds
+ * for AUDIO_BENCH_SECONDS, and prints the throughput, the average
+ * and worst time per buffer, and the cost of each extra channel.
+ * The pass with every channel busy is written to the WAV file.
+ * The minimum gap between repeats of a sound is bypassed, so
+ * every pass mixes exactly its number of channels.
+ *
+ * Returns false if a buffer took longer than it plays for, or
+ * if the file or the sound cache can't be written.
+ **/
+bool bench_audio            (const options *config);
+
+#endif /*BENCH_H*/
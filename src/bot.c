@@ -0,0 +1,103 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#include <SDL.h>
+#include <math.h>
+#include "global.h"
+#include "shared.h"
+
+void update_bots(st_shared *bot)
+{
+    int         i,k;
+    int         target;
+    const float rad_mod = M_PI/180.f;
+    float       dist, min_dist;
+    float       diff;
+    float       speed;
+    player     *p;
+
+    for(i = 0; i < (*bot->config).player_count; i++)
+    {
+        if(!(*bot->config).bot[i])
+            continue;
+        p = &(*bot->plyr)[i];
+        p->key_forward  = false;
+        p->key_backward = false;
+        p->key_left     = false;
+        p->key_right    = false;
+        p->key_shoot    = false;
+        if(p->died) /*wait for respawn*/
+            continue;
+        /*find closest asteroid*/
+        target   = -1;
+        min_dist = 0.f;
+        for(k = 0; k < (*bot->config).aster_max_count; k++)
+        {
+            if(!(*bot->aster)[k].is_spawned)
+                continue;
+            dist = ((*bot->aster)[k].pos[0] - p->pos[0]) *
+                   ((*bot->aster)[k].pos[0] - p->pos[0]) +
+                   ((*bot->aster)[k].pos[1] - p->pos[1]) *
+                   ((*bot->aster)[k].pos[1] - p->pos[1]);
+            if(target < 0 || dist < min_dist)
+            {
+                target   = k;
+                min_dist = dist;
+            }
+        }
+        if(target < 0) /*nothing to shoot at*/
+            continue;
+        min_dist = sqrt(min_dist);
+        /*angle to target, same convention as player rotation*/
+        diff = atan2((*bot->aster)[target].pos[0] - p->pos[0],
+                     (*bot->aster)[target].pos[1] - p->pos[1]) / rad_mod;
+        diff -= p->rot;
+        while(diff > 180.f)
+            diff -= 360.f;
+        while(diff < -180.f)
+            diff += 360.f;
+        /*turn toward target*/
+        if(diff > 4.f)
+            p->key_right = true;
+        else if(diff < -4.f)
+            p->key_left  = true;
+        /*shoot if lined up and in range of projectile*/
+        if(fabs(diff) < 15.f && min_dist < 0.3f +
+                0.04f * (*bot->aster)[target].scale)
+            p->key_shoot = true;
+        /*close distance, but don't let velocity run away*/
+        speed = sqrt(p->vel[0]*p->vel[0] + p->vel[1]*p->vel[1]);
+        if(fabs(diff) < 30.f && min_dist > 0.6f && speed < 0.006f)
+            p->key_forward = true;
+        else if(min_dist < 0.15f && speed < 0.006f) /*back away*/
+            p->key_backward = true;
+    }
+}
+
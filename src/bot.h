@@ -0,0 +1,51 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef BOT_H
+#define BOT_H
+
+#include "shared.h"
+
+/* Update computer controlled players.
+ *
+ *     bot - struct containing variables required for bot players
+ *
+ * Sets the key states of every player slot marked as a bot in
+ * the config. Each bot turns toward the closest asteroid, thrusts
+ * when it is far away, and shoots once it is lined up and in range.
+ * Should be called once per frame, before update_physics().
+ *
+ * Everything in st_shared should point to a defined variable in
+ * the main scope.
+ **/
+void update_bots            (st_shared *bot);
+
+#endif /*BOT_H*/
+
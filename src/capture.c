@@ -0,0 +1,347 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifdef _WIN32
+  #include <Windows.h>
+#endif
+#ifdef __APPLE__
+  #include <Carbon/Carbon.h>
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "glfunc.h"
+#include "global.h"
+#include "shared.h"
+#include "capture.h"
+
+/* Convert a captured frame and write it out.
+ *
+ *     cap  - capture state
+ *     rgba - frame as read by glReadPixels()
+ *
+ * Writes one Y4M 4:2:0 frame using full range BT.601. Rows are
+ * flipped, since GL reads from the bottom up. Each chroma sample
+ * is the average of up to a 2x2 block.
+ **/
+void write_y4m_frame(st_capture *cap, const unsigned char *rgba)
+{
+    int            x,y,i,j;
+    int            r,g,b,n;
+    int            cu,cv;
+    const int      cw = (cap->width  + 1) / 2;
+    const int      ch = (cap->height + 1) / 2;
+    unsigned char *py = cap->yuv;
+    unsigned char *pu = py + cap->width*cap->height;
+    unsigned char *pv = pu + cw*ch;
+    const unsigned char *px;
+
+    for(y = 0; y < cap->height; y++)
+    {
+        px = rgba + (cap->height-1 - y)*cap->width*4;
+        for(x = 0; x < cap->width; x++, px += 4)
+            *py++ = (unsigned char)((77*px[0] + 150*px[1] + 29*px[2]) >> 8);
+    }
+    for(y = 0; y < ch; y++)
+    {
+        for(x = 0; x < cw; x++)
+        {
+            r = g = b = n = 0;
+            for(j = y*2; j < y*2+2 && j < cap->height; j++)
+            {
+                for(i = x*2; i < x*2+2 && i < cap->width; i++)
+                {
+                    px = rgba + ((cap->height-1 - j)*cap->width + i)*4;
+                    r += px[0];
+                    g += px[1];
+                    b += px[2];
+                    n++;
+                }
+            }
+            r /= n;
+            g /= n;
+            b /= n;
+            cu = ((-43*r - 85*g + 128*b) >> 8) + 128;
+            cv = ((128*r - 107*g - 21*b) >> 8) + 128;
+            *pu++ = (unsigned char)(cu < 0 ? 0 : cu > 255 ? 255 : cu);
+            *pv++ = (unsigned char)(cv < 0 ? 0 : cv > 255 ? 255 : cv);
+        }
+    }
+    fputs("FRAME\n", cap->file);
+    fwrite(cap->yuv, 1, cap->width*cap->height + 2*cw*ch, cap->file);
+}
+
+/* Encoder thread main loop.
+ *
+ *     data - the st_capture to encode from
+ *
+ * Writes queued frames in order until asked to quit, and only
+ * quits once the queue is empty.
+ *
+ * Returns 0 when done.
+ **/
+int capture_encoder(void *data)
+{
+    st_capture *cap = (st_capture*) data;
+
+    for(;;)
+    {
+        SDL_SemWait(cap->queued);
+        if(SDL_AtomicGet(&cap->quit) && cap->tail == SDL_AtomicGet(&cap->head))
+            break;
+        write_y4m_frame(cap, cap->queue[cap->tail]);
+        cap->tail = (cap->tail + 1) % CAPTURE_QUEUE;
+        SDL_SemPost(cap->free);
+    }
+    return 0;
+}
+
+/* Get the next free slot of the encoder queue.
+ *
+ *     cap - capture state
+ *
+ * Never waits. Counts the frame as dropped if the encoder is
+ * behind and every slot is taken.
+ *
+ * Returns the slot to fill, or NULL if there isn't one.
+ **/
+unsigned char *capture_slot(st_capture *cap)
+{
+    if(SDL_SemTryWait(cap->free))
+    {
+        cap->dropped++;
+        return NULL;
+    }
+    return cap->queue[SDL_AtomicGet(&cap->head)];
+}
+
+/* Hand the slot from capture_slot() to the encoder.
+ *
+ *     cap - capture state
+ **/
+void capture_push(st_capture *cap)
+{
+    SDL_AtomicSet(&cap->head, (SDL_AtomicGet(&cap->head)+1) % CAPTURE_QUEUE);
+    SDL_SemPost(cap->queued);
+}
+
+/* Copy a finished readback out of its pixel buffer object.
+ *
+ *     cap - capture state
+ *     pbo - index of the buffer in cap->buffers
+ **/
+void capture_map_pbo(st_capture *cap, const unsigned pbo)
+{
+    unsigned char *dst;
+    const void    *src;
+
+    glBindBufferARB_ptr(GL_PIXEL_PACK_BUFFER, cap->buffers[pbo]);
+    src = glMapBufferARB_ptr(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if(src)
+    {
+        if((dst = capture_slot(cap)))
+        {
+            memcpy(dst, src, (size_t)cap->width*cap->height*4);
+            capture_push(cap);
+        }
+        glUnmapBufferARB_ptr(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBufferARB_ptr(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+/* Write the Y4M stream header.
+ *
+ *     cap  - capture state, with the file at its start
+ *     rate - frames per second, in thousandths
+ *
+ * The rate is zero padded to a fixed width, so the header can be
+ * written again over itself once the real rate is known.
+ **/
+void capture_header(st_capture *cap, unsigned long rate)
+{
+    if(rate > 999999999UL)
+        rate = 999999999UL;
+    fprintf(cap->file, "YUV4MPEG2 W%d H%d F%09lu:1000 Ip A1:1 C420jpeg\n",
+            cap->width, cap->height, rate);
+}
+
+/* Start recording.
+ *
+ *     draw - struct containing variables required for capture
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool start_capture(st_shared *draw)
+{
+    int         i;
+    char        name[64];
+    const char *path = draw->config->capture_file;
+    st_capture *cap  = draw->capture;
+    size_t      bytes;
+
+    if(!path)
+    {
+        sprintf(name, "asteroids-%lu.y4m", (unsigned long)time(NULL));
+        path = name;
+    }
+    draw->config->capture_file = NULL; /*don't overwrite it next time*/
+    if(!(cap->file = fopen(path, "wb")))
+    {
+        perror("fopen capture file");
+        return false;
+    }
+    cap->width  = *draw->width_real;
+    cap->height = *draw->height_real;
+    /*a guess until stop_capture() measures the real rate*/
+    capture_header(cap, 60000);
+    bytes = (size_t)cap->width*cap->height*4;
+    for(i = 0; i < CAPTURE_QUEUE; i++)
+        cap->queue[i] = (unsigned char*) malloc(bytes);
+    cap->yuv = (unsigned char*) malloc(bytes);
+    /*a full queue must not look empty, so one slot stays unused*/
+    cap->free   = SDL_CreateSemaphore(CAPTURE_QUEUE - 1);
+    cap->queued = SDL_CreateSemaphore(0);
+    cap->pbo    = !draw->legacy_context && glMapBufferARB_ptr &&
+                  (draw->core_context ||
+                   SDL_GL_ExtensionSupported("GL_ARB_pixel_buffer_object"));
+    if(cap->pbo)
+    {
+        glGenBuffersARB_ptr(CAPTURE_PBOS, cap->buffers);
+        for(i = 0; i < CAPTURE_PBOS; i++)
+        {
+            glBindBufferARB_ptr(GL_PIXEL_PACK_BUFFER, cap->buffers[i]);
+            glBufferDataARB_ptr(GL_PIXEL_PACK_BUFFER, bytes, NULL,
+                    GL_STREAM_READ);
+        }
+        glBindBufferARB_ptr(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    else
+        fprintf(stderr, "Pixel buffer objects not supported. Capture will read frames synchronously.\n");
+    if(!(cap->thread = SDL_CreateThread(capture_encoder, "capture", cap)))
+    {
+        fprintf(stderr, "SDL Create Thread: %s\n", SDL_GetError());
+        SDL_ClearError();
+        stop_capture(draw);
+        return false;
+    }
+    printf("Recording %dx%d video to '%s'\n", cap->width, cap->height, path);
+    return true;
+}
+
+void capture_frame(st_shared *draw)
+{
+    unsigned       pbo;
+    unsigned char *dst;
+    st_capture    *cap = draw->capture;
+
+    if(!*draw->capturing)
+    {
+        stop_capture(draw);
+        cap->failed = false;
+        return;
+    }
+    if(!cap->file && (cap->failed || !start_capture(draw)))
+    {
+        cap->failed = true;
+        return;
+    }
+    cap->last = SDL_GetPerformanceCounter();
+    if(!cap->frames)
+        cap->first = cap->last;
+    if(cap->pbo)
+    {
+        /*this buffer's last readback is CAPTURE_PBOS frames old*/
+        pbo = cap->frames % CAPTURE_PBOS;
+        if(cap->frames >= CAPTURE_PBOS)
+            capture_map_pbo(cap, pbo);
+        glBindBufferARB_ptr(GL_PIXEL_PACK_BUFFER, cap->buffers[pbo]);
+        glReadPixels(0, 0, cap->width, cap->height, GL_RGBA,
+                GL_UNSIGNED_BYTE, (void*)(intptr_t)(0));
+        glBindBufferARB_ptr(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    else if((dst = capture_slot(cap)))
+    {
+        glReadPixels(0, 0, cap->width, cap->height, GL_RGBA,
+                GL_UNSIGNED_BYTE, dst);
+        capture_push(cap);
+    }
+    cap->frames++;
+}
+
+void stop_capture(st_shared *draw)
+{
+    int          i;
+    unsigned     n;
+    st_capture  *cap  = draw->capture;
+    const Uint64 freq = SDL_GetPerformanceFrequency();
+
+    if(!cap || !cap->file)
+        return;
+    if(cap->pbo)
+    {
+        /*frames still in flight, oldest first*/
+        n = cap->frames < CAPTURE_PBOS ? cap->frames : CAPTURE_PBOS;
+        for(; n > 0; n--)
+            capture_map_pbo(cap, (cap->frames - n) % CAPTURE_PBOS);
+        glDeleteBuffersARB_ptr(CAPTURE_PBOS, cap->buffers);
+    }
+    if(cap->thread)
+    {
+        SDL_AtomicSet(&cap->quit, 1);
+        SDL_SemPost(cap->queued);
+        SDL_WaitThread(cap->thread, NULL);
+        printf("Recorded %u frames, %u dropped\n",
+                cap->frames - cap->dropped, cap->dropped);
+    }
+    /*frames are drawn as fast as vsync, the display, or the load
+     *allow, so play back at the rate they were actually kept*/
+    n = cap->frames - cap->dropped;
+    if(n > 1 && cap->last > cap->first)
+    {
+        rewind(cap->file);
+        capture_header(cap, (unsigned long)((double)(n - 1) * 1000.0 *
+                (double)freq /
+                (double)(cap->last - cap->first) + 0.5));
+    }
+    fclose(cap->file);
+    if(cap->free)
+        SDL_DestroySemaphore(cap->free);
+    if(cap->queued)
+        SDL_DestroySemaphore(cap->queued);
+    for(i = 0; i < CAPTURE_QUEUE; i++)
+        free(cap->queue[i]);
+    free(cap->yuv);
+    memset(cap, 0, sizeof(st_capture));
+}
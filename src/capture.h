@@ -0,0 +1,63 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include "shared.h"
+
+/* Record the frame that was just drawn.
+ *
+ *     draw - struct containing variables required for capture
+ *
+ * Starts or stops recording to follow 'capturing', then reads the
+ * back buffer. Should be called after draw_objects() and before the
+ * buffer swap, on the thread that owns the GL context.
+ *
+ * The first recording goes to config 'capture_file' if it is set,
+ * later ones to 'asteroids-TIME.y4m'. Frames are read back through
+ * pixel buffer objects when available, so reading never waits on
+ * the GPU, and are encoded to Y4M on a separate thread. The
+ * header's frame rate is measured from the frames kept, when
+ * recording stops.
+ **/
+void capture_frame          (st_shared *draw);
+
+/* Stop recording.
+ *
+ *     draw - struct containing variables required for capture
+ *
+ * Reads back the frames still in flight, waits for the encoder to
+ * write them, and closes the file. Does nothing if not recording.
+ * Needs the GL context, like capture_frame().
+ **/
+void stop_capture           (st_shared *draw);
+
+#endif /*CAPTURE_H*/
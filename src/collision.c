@@ -30,9 +30,14 @@
 
 #include <SDL.h>
 #include <math.h>
+#include <stdio.h>
+#include <string.h>
 #include "objects.h"
 #include "global.h"
 #include "shared.h"
+#include "mesh.h"
+#include "particles.h"
+#include "audio.h"
 
 /* Detect if a point is in a triangle.
  *
@@ -115,54 +120,330 @@ void get_real_point_pos(const float *original_vector,
 
 /* Detect if two asteroids have collided.
  *
- *     aster_a - bounding triangles, 6x6 float matrix
- *     aster_b - bounding triangles, 6x6 float matrix
+ *     aster_a - bounding triangles, ASTER_EDGES x 6 float matrix
+ *     aster_b - bounding triangles, ASTER_EDGES x 6 float matrix
  *
- * Checks each point of asteroid A with each bounding triangle
- * of asteroid B. Returns true if the asteroids intersect, false
- * if otherwise.
+ * Checks each outline point of asteroid A with each bounding
+ * triangle of asteroid B. Returns true if the asteroids intersect,
+ * false if otherwise.
  **/
-bool detect_aster_collision(float aster_a[6][6],
-                            float aster_b[6][6])
+bool detect_aster_collision(float aster_a[ASTER_EDGES][6],
+                            float aster_b[ASTER_EDGES][6])
 {
-    int i = 0;
+    int i,j;
 
-    for(i = 0; i < 6; i++)
+    for(i = 0; i < ASTER_EDGES; i++)
     {
-        /*point A*/
-        if(detect_point_in_triangle(aster_a[0][0], aster_a[0][1], aster_b[i]))
-            return true;
-        /*point B*/
-        if(detect_point_in_triangle(aster_a[0][2], aster_a[0][3], aster_b[i]))
-            return true;
-        /*point C*/
-        if(detect_point_in_triangle(aster_a[0][4], aster_a[0][5], aster_b[i]))
-            return true;
-        /*point D*/
-        if(detect_point_in_triangle(aster_a[1][2], aster_a[1][3], aster_b[i]))
-            return true;
-        /*point E*/
-        if(detect_point_in_triangle(aster_a[1][4], aster_a[1][5], aster_b[i]))
-            return true;
-        /*point F*/
-        if(detect_point_in_triangle(aster_a[2][2], aster_a[2][3], aster_b[i]))
-            return true;
-        /*point G*/
-        if(detect_point_in_triangle(aster_a[4][4], aster_a[4][5], aster_b[i]))
-            return true;
-        /*point H*/
-        if(detect_point_in_triangle(aster_a[5][4], aster_a[5][5], aster_b[i]))
-            return true;
+        /*outline point 'j' is the second corner of triangle 'j'*/
+        for(j = 0; j < ASTER_EDGES; j++)
+        {
+            if(detect_point_in_triangle(aster_a[j][2], aster_a[j][3],
+                        aster_b[i]))
+                return true;
+        }
     }
     return false;
 }
 
+/* Reset a projectile back to the tip of the player.
+ *
+ *     p - player whose projectile is reset
+ **/
+void reset_shot(player *p)
+{
+    const float rad_mod = M_PI/180.f;
+    p->shot.pos[1]      = 0.04f;
+    p->shot.real_pos[0] = 0.04f * sin(p->rot*rad_mod);
+    p->shot.real_pos[1] = 0.04f * cos(p->rot*rad_mod);
+}
+
+/* Destroy a player's ship.
+ *
+ *     phy - struct containing variables required for physics
+ *     p   - player that was hit
+ *
+ * Marks the player as dead and blows the ship apart into
+ * particles. Players that are already dead are left alone, so
+ * multiple hits in one frame only explode once.
+ *
+ * Returns true if the player was alive, false if not.
+ **/
+bool kill_player(st_shared *phy, player *p)
+{
+    if(p->died)
+        return false;
+    p->died = true;
+    emit_particles(phy->particles, 120, p->pos, p->vel, 0.f, 360.f,
+                   0.02f, 60.f);
+    return true;
+}
+
+/* Take an asteroid from the free pool.
+ *
+ *     phy - struct containing variables required for physics
+ *
+ * The pool is a stack of unspawned asteroid IDs, so allocation
+ * never has to scan the asteroid array. The asteroid is marked
+ * as spawned, everything else is left to the caller.
+ *
+ * Returns the asteroid ID, or -1 if the pool is empty.
+ **/
+int aster_alloc(st_shared *phy)
+{
+    int id;
+
+    if(*phy->aster_free_count < 1)
+        return -1;
+    id = (*phy->aster_free)[--(*phy->aster_free_count)];
+    (*phy->aster)[id].is_spawned = 1;
+    (*phy->aster)[id].collided   = -1;
+    return id;
+}
+
+/* Despawn an asteroid and return it to the free pool.
+ *
+ *     phy - struct containing variables required for physics
+ *     id  - asteroid to despawn
+ **/
+void aster_release(st_shared *phy, const int id)
+{
+    if(!(*phy->aster)[id].is_spawned) /*already in the pool*/
+        return;
+    (*phy->aster)[id].is_spawned = 0;
+    (*phy->aster)[id].collided   = -1;
+    (*phy->aster_free)[(*phy->aster_free_count)++] = id;
+}
+
+void aster_pool_reset(st_shared *phy)
+{
+    int i;
+
+    *phy->aster_free_count = 0;
+    /*push in reverse so the lowest IDs get allocated first*/
+    for(i = (*phy->config).aster_max_count - 1; i >= 0; i--)
+    {
+        if(!(*phy->aster)[i].is_spawned)
+            (*phy->aster_free)[(*phy->aster_free_count)++] = i;
+    }
+}
+
+/* Update the bounding triangles of an asteroid.
+ *
+ *     a - asteroid to update
+ *
+ * The precomputed triangles of its variant are transformed the
+ * same way as get_real_point_pos(), with one sin() and cos() for
+ * the whole asteroid.
+ **/
+void get_aster_bounds(asteroid *a)
+{
+    int          j,k;
+    const float  rad_mod = M_PI/180.f;
+    const float  c = cos(a->rot*rad_mod) * a->scale;
+    const float  s = sin(a->rot*rad_mod) * a->scale;
+    float      (*ref)[6] = mesh_atlas.aster_bounds[a->variant];
+
+    for(k = 0; k < ASTER_EDGES; k++)
+    {
+        for(j = 0; j < 6; j+=2)
+        {
+            a->bounds_real[k][j]   =  ref[k][j]*c + ref[k][j+1]*s + a->pos[0];
+            a->bounds_real[k][j+1] = -ref[k][j]*s + ref[k][j+1]*c + a->pos[1];
+        }
+    }
+}
+
+/* Split a hit asteroid into smaller fragments.
+ *
+ *     phy - struct containing variables required for physics
+ *     id  - asteroid that was hit
+ *
+ * The hit asteroid is reused as the first fragment, and the
+ * rest come from the free pool. Each fragment is one size smaller,
+ * keeps the momentum of the parent, and gets pushed away along
+ * its own slice of a circle. Fragments that don't fit in the
+ * pool are dropped.
+ **/
+void split_asteroid(st_shared *phy, const int id)
+{
+    int         f,i;
+    int         count;
+    const float rad_mod = M_PI/180.f;
+    float       scale, mass, speed;
+    float       parent_pos[2];
+    float       parent_vel[2];
+    float       parent_rot;
+    float       base_angle;
+    asteroid   *a;
+
+    if((*phy->aster)[id].scale < /*MED -> SMALL*/
+            (*phy->config).aster_scale * (ASTER_LARGE+ASTER_MED)*0.5f)
+    {
+        scale = (*phy->config).aster_scale      * ASTER_SMALL;
+        mass  = (*phy->config).aster_mass_small * MASS_SMALL;
+    }
+    else /*LARGE -> MED*/
+    {
+        scale = (*phy->config).aster_scale    * ASTER_MED;
+        mass  = (*phy->config).aster_mass_med * MASS_MED;
+    }
+    count         = (*phy->config).aster_fragments;
+    parent_pos[0] = (*phy->aster)[id].pos[0];
+    parent_pos[1] = (*phy->aster)[id].pos[1];
+    parent_vel[0] = (*phy->aster)[id].vel[0];
+    parent_vel[1] = (*phy->aster)[id].vel[1];
+    parent_rot    = (*phy->aster)[id].rot;
+    base_angle    = (float)(rand()%360);
+    for(f = 0; f < count; f++)
+    {
+        i = f ? aster_alloc(phy) : id;
+        if(i < 0) /*pool is empty*/
+            break;
+        a = &(*phy->aster)[i];
+        a->collided  = -1;
+        a->variant   = rand() % ASTER_VARIANTS;
+        a->scale     = scale;
+        a->mass      = mass;
+        a->pos[0]    = parent_pos[0];
+        a->pos[1]    = parent_pos[1];
+        a->rot       = parent_rot;
+        a->rot_speed = ((rand()%600)-300)*0.01f;
+        /*spread evenly with some jitter*/
+        a->angle     = base_angle + 360.f*(float)f/(float)count +
+                       (float)(rand()%30 - 15);
+        speed        = ((rand()%10)+5)*0.001f;
+        a->vel[0]    = parent_vel[0] + speed*sin(a->angle*rad_mod);
+        a->vel[1]    = parent_vel[1] + speed*cos(a->angle*rad_mod);
+        get_aster_bounds(a);
+    }
+}
+
+void get_player_spawn(const int    index,
+                      const int    count,
+                      float       *pos,
+                      float       *rot)
+{
+    const float rad_mod = M_PI/180.f;
+    float       radius  = 0.f;
+
+    if(count > 1)
+        radius = 0.5f;
+    *rot   = 360.f * (float)index / (float)count;
+    pos[0] = radius * sin(*rot * rad_mod);
+    pos[1] = radius * cos(*rot * rad_mod);
+}
+
+/* Update the window title with every player's score.
+ *
+ *     phy - struct containing variables required for physics
+ *     log - print the title to stdout if there is no window
+ *
+ * In headless mode there is no window, so the scores of each
+ * round are logged instead.
+ **/
+void set_score_title(st_shared *phy, const bool log)
+{
+    int  i;
+    char win_title[64 + 64*PLAYER_MAX] = {'\0'};
+
+    if((*phy->config).player_count == 1) /*1 player*/
+        sprintf(win_title, "Simple Asteroids - Score: %u - Top Score: %u",
+                (*phy->plyr)[0].score, (*phy->plyr)[0].top_score);
+    else
+    {
+        strcpy(win_title, "Simple Asteroids -");
+        for(i = 0; i < (*phy->config).player_count; i++)
+            sprintf(win_title + strlen(win_title),
+                    "%s PLAYER%d Score: %u  Top Score: %u", i ? " /" : "",
+                    i+1, (*phy->plyr)[i].score, (*phy->plyr)[i].top_score);
+    }
+    if(*phy->win_main)
+        SDL_SetWindowTitle(*phy->win_main, win_title);
+    else if(log) /*headless, log each round*/
+        printf("%s\n", win_title);
+}
+
+/* Find pairs of players that might hit each other.
+ *
+ *     phy   - struct containing variables required for physics
+ *     pairs - returns candidate pairs of player indices
+ *
+ * Broadphase for friendly fire. Each living player gets a bounding
+ * box that covers both its ship and its projectile. The boxes are
+ * sorted along x, then swept so only boxes that overlap on both
+ * axes become candidates. 'pairs' must hold at least
+ * PLAYER_MAX*(PLAYER_MAX-1)/2 entries.
+ *
+ * Returns the number of candidate pairs.
+ **/
+int get_player_pairs(st_shared *phy, int pairs[][2])
+{
+    int   i,j,k;
+    int   count      = 0;
+    int   pair_count = 0;
+    int   order[PLAYER_MAX];
+    float box[PLAYER_MAX][4]; /*min x, max x, min y, max y*/
+    float shot[2];
+    player *p;
+
+    for(i = 0; i < (*phy->config).player_count; i++)
+    {
+        p = &(*phy->plyr)[i];
+        if(p->died)
+            continue;
+        box[i][0] = box[i][1] = p->bounds[0];
+        box[i][2] = box[i][3] = p->bounds[1];
+        for(j = 2; j < 8; j+=2)
+        {
+            if(j < 6)
+            {
+                shot[0] = p->bounds[j];
+                shot[1] = p->bounds[j+1];
+            }
+            else if(p->key_shoot) /*projectile tip*/
+            {
+                shot[0] = p->pos[0] + p->shot.real_pos[0];
+                shot[1] = p->pos[1] + p->shot.real_pos[1];
+            }
+            else
+                break;
+            if(shot[0] < box[i][0]) box[i][0] = shot[0];
+            if(shot[0] > box[i][1]) box[i][1] = shot[0];
+            if(shot[1] < box[i][2]) box[i][2] = shot[1];
+            if(shot[1] > box[i][3]) box[i][3] = shot[1];
+        }
+        /*insertion sort by min x*/
+        for(k = count; k > 0 && box[order[k-1]][0] > box[i][0]; k--)
+            order[k] = order[k-1];
+        order[k] = i;
+        count++;
+    }
+    /*sweep*/
+    for(i = 0; i < count; i++)
+    {
+        for(j = i+1; j < count; j++)
+        {
+            if(box[order[j]][0] > box[order[i]][1])
+                break; /*no later box can overlap on x*/
+            if(box[order[j]][2] > box[order[i]][3] ||
+               box[order[j]][3] < box[order[i]][2])
+                continue;
+            pairs[pair_count][0] = order[i];
+            pairs[pair_count][1] = order[j];
+            pair_count++;
+        }
+    }
+    return pair_count;
+}
+
 void update_physics(st_shared *phy)
 {
     int         i,j,k,l;
-    char        win_title[256]   = {'\0'};
-    bool        sound_player_hit = false;
-    bool        sound_aster_hit  = false;
+    int         pair_count;
+    int         exhaust_count;
+    int         pairs[PLAYER_MAX*(PLAYER_MAX-1)/2][2];
+    int         sound_player_hit = 0; /*deaths this update*/
+    int         sound_aster_hit  = 0; /*asteroids shot*/
     bool        skip_remain_time = false;
     const float target_time      = 100.f/6.f; /*~16.67 ms*/
     const float rad_mod          = M_PI/180.f;
@@ -177,39 +458,35 @@ void update_physics(st_shared *phy)
     {
         *phy->ten_second_timer = *phy->current_timer;
         /*spawn new asteroid*/
-        for(i = 0; i < (*phy->config).aster_max_count; i++)
+        i = aster_alloc(phy);
+        if(i >= 0)
         {
-            if(!(*phy->aster)[i].is_spawned)
+            (*phy->aster)[i].variant   = rand() % ASTER_VARIANTS;
+            (*phy->aster)[i].pos[0]    = *phy->left_clip;
+            (*phy->aster)[i].pos[1]    = ((rand()%200)-100)*0.01f;
+            if(rand() & 0x01) /*50%*/
             {
-                (*phy->aster)[i].is_spawned = 1;
-                (*phy->aster)[i].collided  = -1;
-                (*phy->aster)[i].pos[0]    = *phy->left_clip;
-                (*phy->aster)[i].pos[1]    = ((rand()%200)-100)*0.01f;
-                if(rand() & 0x01) /*50%*/
-                {
-                    (*phy->aster)[i].scale = (*phy->config).aster_scale     *
-                                                ASTER_MED;
-                    (*phy->aster)[i].mass  = (*phy->config).aster_mass_med  *
-                                                MASS_MED;
-                }
-                else              /*50%*/
-                {
-                    (*phy->aster)[i].scale = (*phy->config).aster_scale      *
-                                                ASTER_LARGE;
-                    (*phy->aster)[i].mass  = (*phy->config).aster_mass_large *
-                                                MASS_LARGE;
-                }
-                (*phy->aster)[i].rot       = 0.f;
-                (*phy->aster)[i].vel[0]    = ((rand()%20)-10)*0.0005f;
-                (*phy->aster)[i].vel[1]    = ((rand()%20)-10)*0.0005f;
-                (*phy->aster)[i].angle     = (float)(rand()%360);
-                (*phy->aster)[i].vel[0]    = (*phy->aster)[i].vel[0] *
-                                      sin((*phy->aster)[i].angle*rad_mod);
-                (*phy->aster)[i].vel[1]    = (*phy->aster)[i].vel[1] *
-                                      cos((*phy->aster)[i].angle*rad_mod);
-                (*phy->aster)[i].rot_speed = ((rand()%400)-200)*0.01f;
-                break;
+                (*phy->aster)[i].scale = (*phy->config).aster_scale     *
+                                            ASTER_MED;
+                (*phy->aster)[i].mass  = (*phy->config).aster_mass_med  *
+                                            MASS_MED;
+            }
+            else              /*50%*/
+            {
+                (*phy->aster)[i].scale = (*phy->config).aster_scale      *
+                                            ASTER_LARGE;
+                (*phy->aster)[i].mass  = (*phy->config).aster_mass_large *
+                                            MASS_LARGE;
             }
+            (*phy->aster)[i].rot       = 0.f;
+            (*phy->aster)[i].vel[0]    = ((rand()%20)-10)*0.0005f;
+            (*phy->aster)[i].vel[1]    = ((rand()%20)-10)*0.0005f;
+            (*phy->aster)[i].angle     = (float)(rand()%360);
+            (*phy->aster)[i].vel[0]    = (*phy->aster)[i].vel[0] *
+                                  sin((*phy->aster)[i].angle*rad_mod);
+            (*phy->aster)[i].vel[1]    = (*phy->aster)[i].vel[1] *
+                                  cos((*phy->aster)[i].angle*rad_mod);
+            (*phy->aster)[i].rot_speed = ((rand()%400)-200)*0.01f;
         }
     }
     /*** physics ***/
@@ -251,6 +528,21 @@ void update_physics(st_shared *phy)
                     (*phy->plyr)[i].vel[1] += 0.0003f        *
                         cos((*phy->plyr)[i].rot*rad_mod)*
                         (min_time/target_time)*(min_time/target_time);
+                    /*exhaust out of the back of the ship, 2 particles
+                     *per target_time however the frame is split up*/
+                    (*phy->plyr)[i].exhaust += 2.f * (min_time/target_time);
+                    exhaust_count = (int)(*phy->plyr)[i].exhaust;
+                    (*phy->plyr)[i].exhaust -= (float)exhaust_count;
+                    if(min_time > 0.f && exhaust_count > 0)
+                    {
+                        temp_point1[0] = (*phy->plyr)[i].pos[0] - 0.02f *
+                            sin((*phy->plyr)[i].rot*rad_mod);
+                        temp_point1[1] = (*phy->plyr)[i].pos[1] - 0.02f *
+                            cos((*phy->plyr)[i].rot*rad_mod);
+                        emit_particles(phy->particles, exhaust_count,
+                                temp_point1, (*phy->plyr)[i].vel,
+                                (*phy->plyr)[i].rot + 180.f, 30.f, 0.01f, 15.f);
+                    }
                 }
                 if((*phy->plyr)[i].key_backward)
                 {
@@ -297,13 +589,7 @@ void update_physics(st_shared *phy)
                         (min_time/target_time);
                 }
                 else /*reset projectile position*/
-                {
-                    (*phy->plyr)[i].shot.pos[1]      = 0.04f;
-                    (*phy->plyr)[i].shot.real_pos[0] = 0.04f *
-                        sin((*phy->plyr)[i].rot*rad_mod);
-                    (*phy->plyr)[i].shot.real_pos[1] = 0.04f *
-                        cos((*phy->plyr)[i].rot*rad_mod);
-                }
+                    reset_shot(&(*phy->plyr)[i]);
                 /*player bounding triangle*/
                 for(j = 0; j < 6; j+=2)
                 {
@@ -343,36 +629,16 @@ void update_physics(st_shared *phy)
                 if((*phy->aster)[i].rot < 0.f)
                    (*phy->aster)[i].rot = 360.f;
                 /*get asteroid bounding triangles*/
-                for(k = 0; k < 6; k++)
-                {
-                    for(j = 0; j < 6; j+=2)
-                    {
-                        temp_point1[0] = aster_bounds[k][j];
-                        temp_point1[1] = aster_bounds[k][j+1];
-                        get_real_point_pos(temp_point1,
-                                temp_point2,
-                                (*phy->aster)[i].pos,
-                                (*phy->aster)[i].scale,
-                                (*phy->aster)[i].rot);
-                        /*actual position*/
-                        (*phy->aster)[i].bounds_real[k][j]   = temp_point2[0];
-                        (*phy->aster)[i].bounds_real[k][j+1] = temp_point2[1];
-                    }
-                }
+                get_aster_bounds(&(*phy->aster)[i]);
             }
-            /*cycle through each player 'l'*/
-            for(l = 0; l < (*phy->config).player_count; l++)
+            /*detect player-player collision*/
+            if((*phy->config).friendly_fire && *phy->players_alive > 1)
             {
-                if((*phy->plyr)[l].died) /*skip dead player*/
-                    continue;
-                /*detect player-player collision*/
-                for(i = 0; i < (*phy->config).player_count; i++)
+                pair_count = get_player_pairs(phy, pairs);
+                for(k = 0; k < pair_count; k++)
                 {
-                    if(!(*phy->config).friendly_fire ||
-                            *phy->players_alive < 2  ||
-                            l == i                   ||
-                            (*phy->plyr)[i].died)
-                        continue;
+                    l = pairs[k][0];
+                    i = pairs[k][1];
                     for(j = 0; j < 6; j+=2)
                     {
                         /*if player 1 hits player 2 OR player 2 hits player 1*/
@@ -385,43 +651,60 @@ void update_physics(st_shared *phy)
                                     (*phy->plyr)[i].bounds[j+1],
                                     (*phy->plyr)[l].bounds))
                         {
-                            (*phy->plyr)[l].died = true;
-                            (*phy->plyr)[i].died = true;
-                            sound_player_hit     = true;
+                            sound_player_hit +=
+                                kill_player(phy, &(*phy->plyr)[l]);
+                            sound_player_hit +=
+                                kill_player(phy, &(*phy->plyr)[i]);
                         }
                     }
+                    /*check projectile hit, both ways*/
+                    for(j = 0; j < 2; j++)
+                    {
+                        player *shooter = &(*phy->plyr)[pairs[k][j]];
+                        player *target  = &(*phy->plyr)[pairs[k][!j]];
+                        if(!shooter->key_shoot)
+                            continue;
+                        temp_point1[0] = shooter->pos[0] +
+                                         shooter->shot.real_pos[0];
+                        temp_point1[1] = shooter->pos[1] +
+                                         shooter->shot.real_pos[1];
+                        if(!detect_point_in_triangle(temp_point1[0],
+                                    temp_point1[1], target->bounds))
+                            continue; /*skip misses*/
+                        reset_shot(shooter);
+                        /*other player is hit*/
+                        sound_player_hit += kill_player(phy, target);
+                    }
                 }
+            }
+            /*cycle through each player 'l'*/
+            for(l = 0; l < (*phy->config).player_count; l++)
+            {
+                if((*phy->plyr)[l].died) /*skip dead player*/
+                    continue;
                 /*cycle through each asteroid 'k'*/
                 for(k = 0; k < (*phy->config).aster_max_count; k++)
                 {
                     if(!(*phy->aster)[k].is_spawned) /*skip*/
                         continue;
-                    /*check asteroid point to player triangle collision*/
-                    for(i =(object_element_count[0] + object_element_count[2]);
-                            i < (object_element_count[0] +
-                                 object_element_count[2] +
-                                 object_element_count[4]); i+=2)
+                    /*check asteroid point to player triangle collision,
+                     *the outline is already transformed in bounds_real*/
+                    for(i = 0; i < ASTER_EDGES; i++)
                     {
-                        temp_point1[0] = object_verts[i];
-                        temp_point1[1] = object_verts[i+1];
-                        get_real_point_pos(temp_point1,
-                                temp_point2,
-                                (*phy->aster)[k].pos,
-                                (*phy->aster)[k].scale,
-                                (*phy->aster)[k].rot);
                         /*detect damage*/
-                        if(detect_point_in_triangle(temp_point2[0],
-                                    temp_point2[1],
+                        if(detect_point_in_triangle(
+                                    (*phy->aster)[k].bounds_real[i][2],
+                                    (*phy->aster)[k].bounds_real[i][3],
                                     (*phy->plyr)[l].bounds))
                         {
-                            (*phy->plyr)[l].died = true;
-                            sound_player_hit     = true;
+                            sound_player_hit +=
+                                kill_player(phy, &(*phy->plyr)[l]);
                         }
                     }
                     /*check player point to asteroid triangle collision*/
                     for(i = 0; i < 6; i+=2)
                     {
-                        for(j = 0; j < 6; j++)
+                        for(j = 0; j < ASTER_EDGES; j++)
                         {
                             /*detect damage*/
                             if(detect_point_in_triangle(
@@ -429,52 +712,32 @@ void update_physics(st_shared *phy)
                                         (*phy->plyr)[l].bounds[i+1],
                                         (*phy->aster)[k].bounds_real[j]))
                             {
-                                (*phy->plyr)[l].died = true;
-                                sound_player_hit     = true;
+                                sound_player_hit +=
+                                    kill_player(phy, &(*phy->plyr)[l]);
                             }
                         }
                     }
                     /*check projectile collision*/
                     if(!(*phy->plyr)[l].key_shoot) /*skip projectile check*/
                         continue;
-                    get_real_point_pos((*phy->plyr)[l].shot.real_pos,
-                          temp_point1, (*phy->plyr)[l].pos, 1.f, 0.f);
-                    /*check hit on other player*/
-                    for(i = 0; i < (*phy->config).player_count; i++)
-                    {
-                        if(!(*phy->config).friendly_fire ||
-                                *phy->players_alive < 2  ||
-                                l == i                   ||
-                                (*phy->plyr)[i].died)
-                            continue;
-                        if(!detect_point_in_triangle(temp_point1[0],
-                                    temp_point1[1],
-                                    (*phy->plyr)[i].bounds))
-                            continue; /*skip misses*/
-                        /*reset projectile position*/
-                        (*phy->plyr)[l].shot.pos[1]      = 0.04f;
-                        (*phy->plyr)[l].shot.real_pos[0] = 0.04f *
-                            sin((*phy->plyr)[l].rot*rad_mod);
-                        (*phy->plyr)[l].shot.real_pos[1] = 0.04f *
-                            cos((*phy->plyr)[l].rot*rad_mod);
-                        /*other player is hit*/
-                        (*phy->plyr)[i].died = true;
-                        sound_player_hit     = true;
-                    }
+                    temp_point1[0] = (*phy->plyr)[l].pos[0] +
+                                     (*phy->plyr)[l].shot.real_pos[0];
+                    temp_point1[1] = (*phy->plyr)[l].pos[1] +
+                                     (*phy->plyr)[l].shot.real_pos[1];
                     /*check hit on asteroid*/
-                    for(i = 0; i < 6; i++)
+                    for(i = 0; i < ASTER_EDGES; i++)
                     {
                         if(!detect_point_in_triangle(temp_point1[0],
                                     temp_point1[1],
                                     (*phy->aster)[k].bounds_real[i]))
                             continue; /*skip misses*/
-                        /*reset projectile position*/
-                        (*phy->plyr)[l].shot.pos[1]      = 0.04f;
-                        (*phy->plyr)[l].shot.real_pos[0] = 0.04f *
-                            sin((*phy->plyr)[l].rot*rad_mod);
-                        (*phy->plyr)[l].shot.real_pos[1] = 0.04f *
-                            cos((*phy->plyr)[l].rot*rad_mod);
-                        sound_aster_hit = true;
+                        reset_shot(&(*phy->plyr)[l]);
+                        sound_aster_hit++;
+                        /*debris, more for bigger asteroids*/
+                        emit_particles(phy->particles,
+                                (int)((*phy->aster)[k].scale * 8.f),
+                                (*phy->aster)[k].pos, (*phy->aster)[k].vel,
+                                0.f, 360.f, 0.015f, 40.f);
                         /*score*/
                         if((*phy->aster)[k].scale > /*ASTER_LARGE = 1 points*/
                                 (*phy->config).aster_scale *
@@ -487,98 +750,15 @@ void update_physics(st_shared *phy)
                         else /*ASTER_MED = 5 points*/
                             (*phy->plyr)[l].score += 5;
                         /*update scoreboard/window title*/
-                        if((*phy->config).player_count == 1) /*1 player*/
-                            sprintf(win_title,
-                                "Simple Asteroids - Score: %u - Top Score: %u",
-                                    (*phy->plyr)[0].score,
-                                    (*phy->plyr)[0].top_score);
-                        else                         /*2 players*/
-                            sprintf(win_title, "Simple Asteroids - PLAYER1 Score: %u  Top Score: %u    /    PLAYER2 Score: %u  Top Score: %u",
-                                    (*phy->plyr)[0].score,
-                                    (*phy->plyr)[0].top_score,
-                                    (*phy->plyr)[1].score,
-                                    (*phy->plyr)[1].top_score);
-                        SDL_SetWindowTitle(*phy->win_main,win_title);
-                        /*decide whether to spawn little asteroid*/
-                        if((*phy->aster)[k].scale < /*SMALL -> DESPAWN*/
+                        set_score_title(phy, false);
+                        /*SMALL -> DESPAWN, otherwise break it up*/
+                        if((*phy->aster)[k].scale <
                                 (*phy->config).aster_scale *
                                 (ASTER_MED+ASTER_SMALL)*0.5f)
-                        {
-                            (*phy->aster)[k].is_spawned = 0;
-                            (*phy->aster)[k].collided = -1;
-                        }
+                            aster_release(phy, k);
                         else
-                        {
-                            if((*phy->aster)[k].scale < /*MED -> SMALL*/
-                                    (*phy->config).aster_scale *
-                                    (ASTER_LARGE+ASTER_MED)*0.5f)
-                            {
-                                (*phy->aster)[k].scale =
-                                    (*phy->config).aster_scale   * ASTER_SMALL;
-                                (*phy->aster)[k].mass =
-                                    (*phy->config).aster_mass_small*MASS_SMALL;
-                            }
-                            else /*LARGE -> MED*/
-                            {
-                                (*phy->aster)[k].scale =
-                                    (*phy->config).aster_scale    * ASTER_MED;
-                                (*phy->aster)[k].mass =
-                                    (*phy->config).aster_mass_med * MASS_MED;
-                            }
-                            (*phy->aster)[k].collided = -1;
-                            (*phy->aster)[k].vel[0] =
-                                ((rand()%20)-10)*0.001f;
-                            (*phy->aster)[k].vel[1] =
-                                ((rand()%20)-10)*0.001f;
-                            (*phy->aster)[k].angle =
-                                (float)(rand()%360);
-                            (*phy->aster)[k].vel[0] =
-                                (*phy->aster)[k].vel[0] *
-                                sin((*phy->aster)[k].angle*rad_mod);
-                            (*phy->aster)[k].vel[1] =
-                                (*phy->aster)[k].vel[1] *
-                                cos((*phy->aster)[k].angle*rad_mod);
-                            (*phy->aster)[k].rot_speed =
-                                ((rand()%600)-300)*0.01f;
-                            /*chance to spawn additional asteroid*/
-                            for(j = 0; j < (*phy->config).aster_max_count; j++)
-                            {
-                                if((*phy->aster)[j].is_spawned) /*skip*/
-                                    continue;
-                                if(rand() & 0x01) /*50% chance*/
-                                {
-                                    (*phy->aster)[j].is_spawned = 1;
-                                    (*phy->aster)[j].collided = -1;
-                                    (*phy->aster)[j].scale =
-                                        (*phy->config).aster_scale *
-                                        ASTER_SMALL;
-                                    (*phy->aster)[j].mass =
-                                        (*phy->config).aster_mass_small *
-                                        MASS_SMALL;
-                                    (*phy->aster)[j].rot =
-                                        (*phy->aster)[k].rot;
-                                    (*phy->aster)[j].vel[0] =
-                                        ((rand()%20)-10)*0.001f;
-                                    (*phy->aster)[j].vel[1] =
-                                        ((rand()%20)-10)*0.001f;
-                                    (*phy->aster)[j].angle =
-                                        (float)(rand()%360);
-                                    (*phy->aster)[j].vel[0] =
-                                        (*phy->aster)[j].vel[0] *
-                                        sin((*phy->aster)[j].angle*rad_mod);
-                                    (*phy->aster)[j].vel[1] =
-                                        (*phy->aster)[j].vel[1] *
-                                        cos((*phy->aster)[j].angle*rad_mod);
-                                    (*phy->aster)[j].pos[0] =
-                                        (*phy->aster)[k].pos[0];
-                                    (*phy->aster)[j].pos[1] =
-                                        (*phy->aster)[k].pos[1];
-                                    (*phy->aster)[j].rot_speed =
-                                        ((rand()%600)-300)*0.01f;
-                                }
-                                break;
-                            }
-                        }
+                            split_asteroid(phy, k);
+                        break; /*one hit per projectile*/
                     }
                 } /* for(k) boundary checking */
             } /*for(l) cycle through players*/
@@ -665,6 +845,7 @@ void update_physics(st_shared *phy)
                 } /* asteroid-asteroid collision */
             } /* if((*phy->config).physics_enabled) */
         } /* if(*phy->players_alive) */
+        update_particles(phy->particles, min_time/target_time);
 
         /*tally players still alive*/
         *phy->players_alive = 0;
@@ -694,42 +875,28 @@ void update_physics(st_shared *phy)
                 (*phy->plyr)[i].score = 0;
             }
             /*update scoreboard/window title*/
-            if((*phy->config).player_count == 1) /*1 player*/
-                sprintf(win_title,
-                        "Simple Asteroids - Score: %u - Top Score: %u",
-                        (*phy->plyr)[0].score, (*phy->plyr)[0].top_score);
-            else                         /*2 players*/
-                sprintf(win_title, "Simple Asteroids - PLAYER1 Score: %u  Top Score: %u / PLAYER2 Score: %u  Top Score: %u",
-                        (*phy->plyr)[0].score, (*phy->plyr)[0].top_score,
-                        (*phy->plyr)[1].score, (*phy->plyr)[1].top_score);
-            SDL_SetWindowTitle(*phy->win_main,win_title);
+            set_score_title(phy, true);
             /*reset players*/
             for(i = 0; i < (*phy->config).player_count; i++)
             {
                 (*phy->plyr)[i].died        = false;
                 (*phy->plyr)[i].blast_scale = 1.f;
                 (*phy->plyr)[i].blast_reset = true;
-                /*for now, position only accomodates 2 players*/
-                (*phy->plyr)[i].pos[0]      = 0.f;
-                (*phy->plyr)[i].pos[1]      =
-                    (float)((*phy->config).player_count - 1) *
-                    ((float)(i) - 0.5f) * (-1.f);
+                get_player_spawn(i, (*phy->config).player_count,
+                                 (*phy->plyr)[i].pos, &(*phy->plyr)[i].rot);
                 (*phy->plyr)[i].vel[0]      = 0.f;
                 (*phy->plyr)[i].vel[1]      = 0.f;
-                (*phy->plyr)[i].rot         = (float)i * 180.f;
             }
             /*reset asteroids*/
             for(i = (*phy->config).aster_init_count;
                        i < (*phy->config).aster_max_count; i++)
-            {
                 (*phy->aster)[i].is_spawned = 0;
-                (*phy->aster)[i].collided   = -1;
-            }
             for(i = 0; i < (*phy->config).aster_init_count &&
                        i < (*phy->config).aster_max_count; i++)
             {
                 (*phy->aster)[i].is_spawned = 1;
                 (*phy->aster)[i].collided   = -1;
+                (*phy->aster)[i].variant    = rand() % ASTER_VARIANTS;
                 if(rand() & 0x01)      /*50%*/
                 {
                     (*phy->aster)[i].mass  = (*phy->config).aster_mass_small
@@ -762,52 +929,17 @@ void update_physics(st_shared *phy)
                                         cos((*phy->aster)[i].angle*rad_mod);
                 (*phy->aster)[i].rot_speed = ((rand()%400)-200)*0.01f;
             }
+            aster_pool_reset(phy);
         }
         *phy->frame_time -= min_time; /*decrement remaining time*/
     } /*while(frame_time > 0.f)*/
-    /*play sounds*/
-    if(sound_player_hit && phy->config->audio_enabled)
+    /*play sounds, one per hit up to SOUND_BURST; the mixer spreads
+     *them out and drops what it can't fit*/
+    if(phy->config->audio_enabled)
     {
-        for(i = 0; i < AUDIO_MIX_CHANNELS; i++)
-        {
-            if(!(phy->sfx_main)[i].silence)
-                continue;
-            (phy->sfx_main)[i].sfx_nr   = SFX_PLAYER_HIT;
-            (phy->sfx_main)[i].note_nr  = 0;
-            (phy->sfx_main)[i].i        = 0;
-            (phy->sfx_main)[i].waveform = 2;
-            (phy->sfx_main)[i].amp      = 1.f;
-            (phy->sfx_main)[i].freq     = 1.f;
-            (phy->sfx_main)[i].env      = 0.8f;
-            (phy->sfx_main)[i].attack   = 0;
-            (phy->sfx_main)[i].decay    = 0;
-            (phy->sfx_main)[i].sustain  = AUDIO_CALLBACK_BYTES*15;
-            (phy->sfx_main)[i].release  = AUDIO_CALLBACK_BYTES*10;
-            (phy->sfx_main)[i].silence  = false;
-            break;
-        }
-        sound_player_hit = false;
-    }
-    if(sound_aster_hit && phy->config->audio_enabled)
-    {
-        for(i = 0; i < AUDIO_MIX_CHANNELS; i++)
-        {
-            if(!(phy->sfx_main)[i].silence)
-                continue;
-            (phy->sfx_main)[i].sfx_nr   = SFX_ASTER_HIT;
-            (phy->sfx_main)[i].note_nr  = 0;
-            (phy->sfx_main)[i].i        = 0;
-            (phy->sfx_main)[i].waveform = 2;
-            (phy->sfx_main)[i].amp      = 1.f;
-            (phy->sfx_main)[i].freq     = 1.f;
-            (phy->sfx_main)[i].env      = 0.8f;
-            (phy->sfx_main)[i].attack   = 0;
-            (phy->sfx_main)[i].decay    = 0;
-            (phy->sfx_main)[i].sustain  = 0;
-            (phy->sfx_main)[i].release  = AUDIO_CALLBACK_BYTES*16;
-            (phy->sfx_main)[i].silence  = false;
-            break;
-        }
-        sound_aster_hit = false;
+        for(i = 0; i < sound_player_hit && i < SOUND_BURST; i++)
+            play_sound(phy->mixer, SOUND_PLAYER_HIT);
+        for(i = 0; i < sound_aster_hit && i < SOUND_BURST; i++)
+            play_sound(phy->mixer, SOUND_ASTER_HIT);
     }
 }
@@ -42,5 +42,31 @@
  **/
 void update_physics         (st_shared *phy);
 
+/* Refill the pool of free asteroids.
+ *
+ *     phy - struct containing variables required for physics
+ *
+ * Every asteroid that isn't spawned is pushed onto the free
+ * pool. Call this whenever asteroids are spawned or despawned
+ * directly instead of through the pool, like on a new round.
+ **/
+void aster_pool_reset       (st_shared *phy);
+
+/* Get the spawn point of a player.
+ *
+ *     index - player number, starting at 0
+ *     count - total number of players
+ *     pos   - {x,y} vector to pass the position
+ *     rot   - passes the rotation in degrees
+ *
+ * Players are spread evenly on a ring around the center of the
+ * screen, each facing away from it. A single player spawns in
+ * the center.
+ **/
+void get_player_spawn       (const int    index,
+                             const int    count,
+                             float       *pos,
+                             float       *rot);
+
 #endif /*COLLISION_H*/
 
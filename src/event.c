@@ -32,15 +32,81 @@
 #include "global.h"
 #include "shared.h"
 
+/* Set the key state of any player bound to a scancode.
+ *
+ *     ev       - struct containing variables required for polling events
+ *     scancode - key that was pressed or released
+ *     state    - true if pressed, false if released
+ *
+ * Walks the per-player key bindings, so every player slot up to
+ * config.player_count is handled the same way. The alternate shoot
+ * key only applies when there is a single player.
+ **/
+void set_player_key(st_shared *ev, const unsigned scancode, const bool state)
+{
+    int            i;
+    st_playerkeys *keys;
+
+    if(scancode == SDL_SCANCODE_UNKNOWN) /*never matches unbound keys*/
+        return;
+    if(ev->config->player_count == 1 &&
+            scancode == ev->config->keybind.p1_altshoot)
+    {
+        (*ev->plyr)[0].key_shoot = state;
+        return;
+    }
+    for(i = 0; i < ev->config->player_count; i++)
+    {
+        keys = &ev->config->keybind.player[i];
+        if(scancode == keys->forward)
+            (*ev->plyr)[i].key_forward  = state;
+        else if(scancode == keys->backward)
+            (*ev->plyr)[i].key_backward = state;
+        else if(scancode == keys->left)
+            (*ev->plyr)[i].key_left     = state;
+        else if(scancode == keys->right)
+            (*ev->plyr)[i].key_right    = state;
+        else if(scancode == keys->shoot && ev->config->player_count > 1)
+            (*ev->plyr)[i].key_shoot    = state;
+    }
+}
+
 void poll_events(st_shared *ev)
 {
     SDL_Event event_main;
+    int       volume;
+
     while(SDL_PollEvent(&event_main))
     {
         if(event_main.type == SDL_WINDOWEVENT)
         {
-            if(event_main.window.event == SDL_WINDOWEVENT_CLOSE)
-                *ev->loop_exit     = true;
+            switch(event_main.window.event)
+            {
+                case SDL_WINDOWEVENT_CLOSE:
+                    *ev->loop_exit = true;
+                    break;
+                case SDL_WINDOWEVENT_MINIMIZED:
+                    *ev->minimized = true;
+                    break;
+                case SDL_WINDOWEVENT_RESTORED:
+                    *ev->minimized = false;
+                    *ev->redraw    = true;
+                    break;
+                case SDL_WINDOWEVENT_FOCUS_LOST:
+                    *ev->unfocused = true;
+                    break;
+                case SDL_WINDOWEVENT_FOCUS_GAINED:
+                    *ev->unfocused = false;
+                    *ev->redraw    = true;
+                    break;
+                case SDL_WINDOWEVENT_SHOWN:
+                case SDL_WINDOWEVENT_EXPOSED:
+                case SDL_WINDOWEVENT_SIZE_CHANGED:
+                    *ev->redraw    = true;
+                    break;
+                default:
+                    break;
+            }
         }
         else if(event_main.type == SDL_QUIT)
                 *ev->loop_exit     = true;
@@ -56,6 +122,7 @@ void poll_events(st_shared *ev)
                    *ev->paused     = false;
                 else
                    *ev->paused     = true;
+                *ev->redraw        = true;
             }
             else if(event_main.key.keysym.scancode ==
                     ev->config->keybind.debug)
@@ -64,98 +131,33 @@ void poll_events(st_shared *ev)
                    *ev->show_fps   = false;
                 else
                    *ev->show_fps   = true;
+                *ev->redraw        = true;
             }
             else if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.vol_down)
+                    ev->config->keybind.capture)
             {
-                (ev->sfx_main)[0].volume -= 5;
-                if((ev->sfx_main)[0].volume < 0)
-                   (ev->sfx_main)[0].volume = 0;
+                if(*ev->capturing)
+                   *ev->capturing  = false;
+                else
+                   *ev->capturing  = true;
             }
             else if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.vol_up)
+                    ev->config->keybind.vol_down)
             {
-                (ev->sfx_main)[0].volume += 5;
-                if((ev->sfx_main)[0].volume > 127)
-                   (ev->sfx_main)[0].volume = 127;
+                volume = SDL_AtomicGet(&ev->mixer->volume) - 5;
+                SDL_AtomicSet(&ev->mixer->volume, volume < 0 ? 0 : volume);
             }
             else if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_forward)
-                (*ev->plyr)[0].key_forward  = true;
-            else if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_backward)
-                (*ev->plyr)[0].key_backward = true;
-            else if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_left)
-                (*ev->plyr)[0].key_left     = true;
-            else if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_right)
-                (*ev->plyr)[0].key_right    = true;
-            else if(ev->config->player_count == 1 &&
-                    event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_altshoot)
-                (*ev->plyr)[0].key_shoot    = true;
-            else if(ev->config->player_count > 1)
+                    ev->config->keybind.vol_up)
             {
-                if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p1_shoot)
-                    (*ev->plyr)[0].key_shoot    = true;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_forward)
-                    (*ev->plyr)[1].key_forward  = true;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_backward)
-                    (*ev->plyr)[1].key_backward = true;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_left)
-                    (*ev->plyr)[1].key_left     = true;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_right)
-                    (*ev->plyr)[1].key_right    = true;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_shoot)
-                    (*ev->plyr)[1].key_shoot    = true;
+                volume = SDL_AtomicGet(&ev->mixer->volume) + 5;
+                SDL_AtomicSet(&ev->mixer->volume,
+                              volume > 127 ? 127 : volume);
             }
+            else
+                set_player_key(ev, event_main.key.keysym.scancode, true);
         }
         else if(event_main.type == SDL_KEYUP)
-        {
-            if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_forward)
-                (*ev->plyr)[0].key_forward  = false;
-            else if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_backward)
-                (*ev->plyr)[0].key_backward = false;
-            else if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_left)
-                (*ev->plyr)[0].key_left     = false;
-            else if(event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_right)
-                (*ev->plyr)[0].key_right    = false;
-            else if(ev->config->player_count == 1 &&
-                    event_main.key.keysym.scancode ==
-                    ev->config->keybind.p1_altshoot)
-                (*ev->plyr)[0].key_shoot    = false;
-            else if(ev->config->player_count > 1)
-            {
-                if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p1_shoot)
-                    (*ev->plyr)[0].key_shoot    = false;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_forward)
-                    (*ev->plyr)[1].key_forward  = false;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_backward)
-                    (*ev->plyr)[1].key_backward = false;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_left)
-                    (*ev->plyr)[1].key_left     = false;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_right)
-                    (*ev->plyr)[1].key_right    = false;
-                else if(event_main.key.keysym.scancode ==
-                        ev->config->keybind.p2_shoot)
-                    (*ev->plyr)[1].key_shoot    = false;
-            }
-        }
+            set_player_key(ev, event_main.key.keysym.scancode, false);
     }
 }
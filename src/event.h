@@ -38,7 +38,8 @@
  *     ev - struct containing variables required for polling events
  *
  * Everything in st_shared should point to a defined variable in the
- * main scope.
+ * main scope. Window events update 'minimized' and 'unfocused', and
+ * anything that changes what an idle frame shows sets 'redraw'.
  **/
 void poll_events            (st_shared *ev);
 
@@ -0,0 +1,431 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifdef _WIN32
+  #include <Windows.h>
+#endif
+#ifdef __APPLE__
+  #include <Carbon/Carbon.h>
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+#include <SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include "glfunc.h"
+#include "glstats.h"
+#include "global.h"
+#include "shared.h"
+#include "stream.h"
+#include "particles.h"
+#include "mesh.h"
+
+/*turn a define into a string for shader source*/
+#define GLSL_INT_(x) #x
+#define GLSL_INT(x)  GLSL_INT_(x)
+
+/*object vertices are rotated, scaled, then translated by the
+ *instance (same order as get_real_point_pos()), then mapped
+ *from the clip rect to normalized device coords. Asteroids are
+ *all drawn with the first variant's indices, and each instance
+ *swaps in the outline of its own variant from 'aster'*/
+const GLchar *core_vert_src[] = {
+    "#version 330 core\n",
+    "layout(location = 0) in vec2 vert;\n",
+    "layout(location = 1) in vec4 inst;  /*x, y, scale, rotation*/\n",
+    "layout(location = 2) in float shape; /*variant, -1 if not aster*/\n",
+    "uniform vec4 view;                  /*left, right, bottom, top*/\n",
+    "uniform vec2 aster[" GLSL_INT(ASTER_VARIANTS) "*"
+                          GLSL_INT(ASTER_EDGES) "];\n",
+    "uniform int  aster_first;           /*atlas vertex of aster[0]*/\n",
+    "void main()\n",
+    "{\n",
+    "    float r = radians(inst.w);\n",
+    "    vec2  v = shape < 0.0 ? vert : aster[int(shape)*"
+                  GLSL_INT(ASTER_EDGES) " + gl_VertexID - aster_first];\n",
+    "    vec2  p = mat2(cos(r), -sin(r), sin(r), cos(r)) * v;\n",
+    "    p = p*inst.z + inst.xy;\n",
+    "    gl_Position = vec4((p - view.xz)/(view.yw - view.xz)*2.0 - 1.0,\n",
+    "                       0.0, 1.0);\n",
+    "}\n"};
+
+const GLchar *core_frag_src[] = {
+    "#version 330 core\n",
+    "out vec4 color;\n",
+    "void main()\n",
+    "{\n",
+    "    color = vec4(1.0);\n",
+    "}\n"};
+
+/*one triangle covering the screen, textured with the scaled scene*/
+const GLchar *core_scale_vert_src[] = {
+    "#version 330 core\n",
+    "out vec2 uv;\n",
+    "void main()\n",
+    "{\n",
+    "    uv = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0;\n",
+    "    gl_Position = vec4(uv*2.0 - 1.0, 0.0, 1.0);\n",
+    "}\n"};
+
+const GLchar *core_scale_frag_src[] = {
+    "#version 330 core\n",
+    "uniform sampler2D scene;\n",
+    "in vec2 uv;\n",
+    "out vec4 color;\n",
+    "void main()\n",
+    "{\n",
+    "    color = texture(scene, uv);\n",
+    "}\n"};
+
+/* Compile a shader.
+ *
+ *     type  - GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+ *     src   - source, one line per string
+ *     lines - number of strings in src
+ *
+ * Returns the shader, or 0 if it doesn't compile.
+ **/
+GLuint compile_shader(const GLenum type, const GLchar **src, const int lines)
+{
+    GLuint shader;
+    GLint  status = 0;
+    char   info[512] = {'\0'};
+
+    shader = glCreateShader_ptr(type);
+    glShaderSource_ptr(shader, lines, src, NULL);
+    glCompileShader_ptr(shader);
+    glGetShaderiv_ptr(shader, GL_COMPILE_STATUS, &status);
+    if(!status)
+    {
+        glGetShaderInfoLog_ptr(shader, sizeof(info), NULL, info);
+        fprintf(stderr, "Shader compile: %s\n", info);
+        glDeleteShader_ptr(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool init_core(st_shared *init)
+{
+    int    aster_first;
+    GLuint vao = 0;
+    GLuint program;
+    GLuint vert, frag;
+    GLint  status = 0;
+    char   info[512] = {'\0'};
+
+    /*fetch GL core functions*/
+    *(void **) (&glGenBuffersARB_ptr) =
+        SDL_GL_GetProcAddress("glGenBuffers");
+    *(void **) (&glDeleteBuffersARB_ptr) =
+        SDL_GL_GetProcAddress("glDeleteBuffers");
+    *(void **) (&glBindBufferARB_ptr) =
+        SDL_GL_GetProcAddress("glBindBuffer");
+    *(void **) (&glBufferDataARB_ptr) =
+        SDL_GL_GetProcAddress("glBufferData");
+    *(void **) (&glBufferSubDataARB_ptr) =
+        SDL_GL_GetProcAddress("glBufferSubData");
+    *(void **) (&glMapBufferARB_ptr) =
+        SDL_GL_GetProcAddress("glMapBuffer");
+    *(void **) (&glUnmapBufferARB_ptr) =
+        SDL_GL_GetProcAddress("glUnmapBuffer");
+    *(void **) (&glMapBufferRange_ptr) =
+        SDL_GL_GetProcAddress("glMapBufferRange");
+    *(void **) (&glGenVertexArrays_ptr) =
+        SDL_GL_GetProcAddress("glGenVertexArrays");
+    *(void **) (&glBindVertexArray_ptr) =
+        SDL_GL_GetProcAddress("glBindVertexArray");
+    *(void **) (&glVertexAttribPointer_ptr) =
+        SDL_GL_GetProcAddress("glVertexAttribPointer");
+    *(void **) (&glEnableVertexAttribArray_ptr) =
+        SDL_GL_GetProcAddress("glEnableVertexAttribArray");
+    *(void **) (&glDisableVertexAttribArray_ptr) =
+        SDL_GL_GetProcAddress("glDisableVertexAttribArray");
+    *(void **) (&glVertexAttribDivisor_ptr) =
+        SDL_GL_GetProcAddress("glVertexAttribDivisor");
+    *(void **) (&glVertexAttrib4f_ptr) =
+        SDL_GL_GetProcAddress("glVertexAttrib4f");
+    *(void **) (&glDrawElementsInstanced_ptr) =
+        SDL_GL_GetProcAddress("glDrawElementsInstanced");
+    *(void **) (&glCreateShader_ptr) =
+        SDL_GL_GetProcAddress("glCreateShader");
+    *(void **) (&glShaderSource_ptr) =
+        SDL_GL_GetProcAddress("glShaderSource");
+    *(void **) (&glCompileShader_ptr) =
+        SDL_GL_GetProcAddress("glCompileShader");
+    *(void **) (&glGetShaderiv_ptr) =
+        SDL_GL_GetProcAddress("glGetShaderiv");
+    *(void **) (&glGetShaderInfoLog_ptr) =
+        SDL_GL_GetProcAddress("glGetShaderInfoLog");
+    *(void **) (&glDeleteShader_ptr) =
+        SDL_GL_GetProcAddress("glDeleteShader");
+    *(void **) (&glCreateProgram_ptr) =
+        SDL_GL_GetProcAddress("glCreateProgram");
+    *(void **) (&glAttachShader_ptr) =
+        SDL_GL_GetProcAddress("glAttachShader");
+    *(void **) (&glLinkProgram_ptr) =
+        SDL_GL_GetProcAddress("glLinkProgram");
+    *(void **) (&glGetProgramiv_ptr) =
+        SDL_GL_GetProcAddress("glGetProgramiv");
+    *(void **) (&glGetProgramInfoLog_ptr) =
+        SDL_GL_GetProcAddress("glGetProgramInfoLog");
+    *(void **) (&glUseProgram_ptr) =
+        SDL_GL_GetProcAddress("glUseProgram");
+    *(void **) (&glGetUniformLocation_ptr) =
+        SDL_GL_GetProcAddress("glGetUniformLocation");
+    *(void **) (&glUniform4f_ptr) =
+        SDL_GL_GetProcAddress("glUniform4f");
+    *(void **) (&glUniform1i_ptr) =
+        SDL_GL_GetProcAddress("glUniform1i");
+    *(void **) (&glUniform2fv_ptr) =
+        SDL_GL_GetProcAddress("glUniform2fv");
+    if(!glGenBuffersARB_ptr || !glBindBufferARB_ptr || !glBufferDataARB_ptr ||
+       !glGenVertexArrays_ptr || !glBindVertexArray_ptr ||
+       !glVertexAttribPointer_ptr || !glEnableVertexAttribArray_ptr ||
+       !glDisableVertexAttribArray_ptr || !glVertexAttribDivisor_ptr ||
+       !glVertexAttrib4f_ptr || !glDrawElementsInstanced_ptr ||
+       !glCreateShader_ptr || !glShaderSource_ptr || !glCompileShader_ptr ||
+       !glGetShaderiv_ptr || !glGetShaderInfoLog_ptr || !glDeleteShader_ptr ||
+       !glCreateProgram_ptr || !glAttachShader_ptr || !glLinkProgram_ptr ||
+       !glGetProgramiv_ptr || !glGetProgramInfoLog_ptr ||
+       !glUseProgram_ptr || !glGetUniformLocation_ptr || !glUniform4f_ptr ||
+       !glUniform1i_ptr || !glUniform2fv_ptr)
+    {
+        fprintf(stderr, "Missing OpenGL 3.3 core functions.\n");
+        return false;
+    }
+    /*** Shaders ***/
+    vert = compile_shader(GL_VERTEX_SHADER, core_vert_src,
+            sizeof(core_vert_src)/sizeof(core_vert_src[0]));
+    frag = compile_shader(GL_FRAGMENT_SHADER, core_frag_src,
+            sizeof(core_frag_src)/sizeof(core_frag_src[0]));
+    if(!vert || !frag)
+        return false;
+    program = glCreateProgram_ptr();
+    glAttachShader_ptr(program, vert);
+    glAttachShader_ptr(program, frag);
+    glLinkProgram_ptr(program);
+    glDeleteShader_ptr(vert);
+    glDeleteShader_ptr(frag);
+    glGetProgramiv_ptr(program, GL_LINK_STATUS, &status);
+    if(!status)
+    {
+        glGetProgramInfoLog_ptr(program, sizeof(info), NULL, info);
+        fprintf(stderr, "Shader link: %s\n", info);
+        return false;
+    }
+    glUseProgram_ptr(program);
+    init->core_view = glGetUniformLocation_ptr(program, "view");
+    /*asteroid variants are back to back in the atlas*/
+    aster_first = mesh_atlas.index[mesh_atlas.mesh[MESH_ASTER].first];
+    glUniform2fv_ptr(glGetUniformLocation_ptr(program, "aster"),
+            ASTER_VARIANTS*ASTER_EDGES, &mesh_atlas.verts[aster_first*2]);
+    glUniform1i_ptr(glGetUniformLocation_ptr(program, "aster_first"),
+            aster_first);
+    /*** Vertex Array Object ***/
+    glGenVertexArrays_ptr(1, &vao);
+    glBindVertexArray_ptr(vao);
+    glEnableVertexAttribArray_ptr(0);
+    /*instance attribute, pointed at the stream buffer per draw*/
+    glEnableVertexAttribArray_ptr(1);
+    glVertexAttribDivisor_ptr(1, 1);
+    /*asteroid variant, only an array while drawing asteroids*/
+    glVertexAttribDivisor_ptr(2, 1);
+    glVertexAttrib4f_ptr(2, -1.f, 0.f, 0.f, 1.f);
+    return true;
+}
+
+bool init_core_scale(st_shared *init)
+{
+    GLuint program;
+    GLuint vert, frag;
+    GLint  status = 0;
+    GLint  scene  = 0;
+
+    vert = compile_shader(GL_VERTEX_SHADER, core_scale_vert_src,
+            sizeof(core_scale_vert_src)/sizeof(core_scale_vert_src[0]));
+    frag = compile_shader(GL_FRAGMENT_SHADER, core_scale_frag_src,
+            sizeof(core_scale_frag_src)/sizeof(core_scale_frag_src[0]));
+    if(!vert || !frag)
+        return false;
+    program = glCreateProgram_ptr();
+    glAttachShader_ptr(program, vert);
+    glAttachShader_ptr(program, frag);
+    glLinkProgram_ptr(program);
+    glDeleteShader_ptr(vert);
+    glDeleteShader_ptr(frag);
+    glGetProgramiv_ptr(program, GL_LINK_STATUS, &status);
+    if(!status)
+        return false;
+    /*'scene' samples texture unit 0, the default*/
+    glGetIntegerv(GL_CURRENT_PROGRAM, &scene);
+    init->scale.program = program;
+    init->scale.scene   = (unsigned)scene;
+    return true;
+}
+
+void draw_core_scale(st_shared *draw)
+{
+    glUseProgram_ptr(draw->scale.program);
+    glBindTexture(GL_TEXTURE_2D, draw->scale.texture);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glUseProgram_ptr(draw->scale.scene);
+}
+
+/* Add an instance to the staging array.
+ *
+ *     inst  - staging array, 4 floats per instance
+ *     n     - index of the instance
+ *     x,y   - position
+ *     scale - scaling factor
+ *     rot   - rotation in degrees
+ **/
+void add_instance(float      *inst,
+                  const int   n,
+                  const float x,
+                  const float y,
+                  const float scale,
+                  const float rot)
+{
+    inst[n*4]   = x;
+    inst[n*4+1] = y;
+    inst[n*4+2] = scale;
+    inst[n*4+3] = rot;
+}
+
+void draw_core_objects(st_shared *draw)
+{
+    int           i,j;
+    int           n = 0;
+    int           first[5]; /*asteroids, players, projectiles, blasts, end*/
+    unsigned      offset;
+    const int     mesh[4]  = {MESH_ASTER, MESH_PLAYER, MESH_PROJECTILE,
+                              MESH_BLAST};
+    const float   rad_mod  = M_PI/180.f;
+    const st_mesh *m;
+    float         c,s;
+    float        *inst     = draw->aster_batch;
+    player       *p;
+
+    glViewport(0, 0, draw->scale.width, draw->scale.height);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glUniform4f_ptr(draw->core_view, *draw->left_clip, *draw->right_clip,
+            *draw->bottom_clip, *draw->top_clip);
+    /*particles, as points with a constant identity instance*/
+    i = batch_particles(draw->particles, draw->particle_batch);
+    if(i)
+    {
+        offset = stream_write(&draw->stream, draw->particle_batch,
+                sizeof(float)*2*i);
+        glDisableVertexAttribArray_ptr(1);
+        glVertexAttrib4f_ptr(1, 0.f, 0.f, 1.f, 0.f);
+        glVertexAttribPointer_ptr(0, 2, GL_FLOAT, GL_FALSE, 0,
+                (void*)(intptr_t)(offset));
+        glDrawArrays(GL_POINTS, 0, i);
+        /*back to the static object buffer*/
+        glBindBufferARB_ptr(GL_ARRAY_BUFFER, draw->gl_buffers[0]);
+        glVertexAttribPointer_ptr(0, 2, GL_FLOAT, GL_FALSE, 0,
+                (void*)(intptr_t)(0));
+        glEnableVertexAttribArray_ptr(1);
+    }
+    /*asteroids*/
+    first[0] = n;
+    for(i = 0; i < (*draw->config).aster_max_count; i++)
+    {
+        if((*draw->aster)[i].is_spawned)
+            add_instance(inst, n++, (*draw->aster)[i].pos[0],
+                    (*draw->aster)[i].pos[1], (*draw->aster)[i].scale,
+                    (*draw->aster)[i].rot);
+    }
+    /*players*/
+    first[1] = n;
+    for(i = 0; i < (*draw->config).player_count; i++)
+    {
+        p = &(*draw->plyr)[i];
+        if(!p->died)
+            add_instance(inst, n++, p->pos[0], p->pos[1], 1.f, p->rot);
+    }
+    /*projectiles, offset in the ship's frame like the fixed path*/
+    first[2] = n;
+    for(i = 0; i < (*draw->config).player_count; i++)
+    {
+        p = &(*draw->plyr)[i];
+        if(p->died || !p->key_shoot || *draw->paused)
+            continue;
+        c = cos(p->rot*rad_mod);
+        s = sin(p->rot*rad_mod);
+        add_instance(inst, n++,
+                p->pos[0] + p->shot.pos[0]*c + p->shot.pos[1]*s,
+                p->pos[1] - p->shot.pos[0]*s + p->shot.pos[1]*c,
+                1.f, p->rot);
+    }
+    /*player death effect, second one smaller at 90 degrees*/
+    first[3] = n;
+    for(i = 0; i < (*draw->config).player_count; i++)
+    {
+        p = &(*draw->plyr)[i];
+        if(!p->died)
+            continue;
+        add_instance(inst, n++, p->pos[0], p->pos[1], p->blast_scale, 0.f);
+        add_instance(inst, n++, p->pos[0], p->pos[1],
+                p->blast_scale*0.5f, 90.f);
+    }
+    first[4] = n;
+    if(!n)
+        return;
+    /*asteroid variants after the instances, in the same write*/
+    for(i = 0, j = 4*n; i < (*draw->config).aster_max_count; i++)
+    {
+        if((*draw->aster)[i].is_spawned)
+            inst[j++] = (float)(*draw->aster)[i].variant;
+    }
+    offset = stream_write(&draw->stream, inst, sizeof(float)*j);
+    /*one instanced draw per object type*/
+    for(i = 0; i < 4; i++)
+    {
+        if(first[i+1] == first[i])
+            continue;
+        m = &mesh_atlas.mesh[mesh[i]];
+        glVertexAttribPointer_ptr(1, 4, GL_FLOAT, GL_FALSE, 0,
+                (void*)(intptr_t)(offset + sizeof(float)*4*first[i]));
+        if(mesh[i] == MESH_ASTER)
+        {
+            glEnableVertexAttribArray_ptr(2);
+            glVertexAttribPointer_ptr(2, 1, GL_FLOAT, GL_FALSE, 0,
+                    (void*)(intptr_t)(offset + sizeof(float)*4*n));
+        }
+        glDrawElementsInstanced_ptr(m->mode, m->count, GL_UNSIGNED_SHORT,
+                (void*)(intptr_t)(sizeof(unsigned short)*m->first),
+                first[i+1] - first[i]);
+        if(mesh[i] == MESH_ASTER)
+            glDisableVertexAttribArray_ptr(2);
+    }
+}
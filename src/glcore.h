@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef GLCORE_H
+#define GLCORE_H
+
+#include "shared.h"
+
+/* Set up the OpenGL 3.3 core renderer.
+ *
+ *     init - struct containing variables required for init
+ *
+ * Loads the core function pointers, builds the shader program,
+ * and binds a vertex array object with attribute 0 (object
+ * vertices) and attribute 1 (per-instance x, y, scale, rotation)
+ * enabled. Buffers are created by init_gl() afterwards. Needs a
+ * current 3.3 core context.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool init_core              (st_shared *init);
+
+/* Build the shader that stretches the scaled scene to the window.
+ *
+ *     init - struct containing variables required for init
+ *
+ * Called by init_scale(). Remembers the current program as the one
+ * to go back to after each stretch.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool init_core_scale        (st_shared *init);
+
+/* Stretch the scaled scene to the window with shaders.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * Draws one triangle over the whole viewport, sampling
+ * draw->scale.texture, then switches back to the scene program.
+ **/
+void draw_core_scale        (st_shared *draw);
+
+/* Draw particles, asteroids, players, projectiles, and blasts with shaders.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * Clears the screen, then draws each kind of object with a single
+ * instanced call. The HUD is left to draw_text().
+ **/
+void draw_core_objects      (st_shared *draw);
+
+#endif /*GLCORE_H*/
@@ -0,0 +1,269 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef GLFUNC_H
+#define GLFUNC_H
+
+#ifdef _WIN32
+  #include <Windows.h>
+#endif
+#ifdef __APPLE__
+  #include <Carbon/Carbon.h>
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+#ifdef _WIN32
+  #include <SDL_opengl_glext.h>
+#endif
+
+/*** GL extension function pointers ***
+ *
+ * Everything but the legacy renderer needs
+ * ARB_vertex_buffer_object, which is available since OpenGL 1.5
+ *
+ * glGenBuffers */
+typedef void (APIENTRY * glGenBuffersARB_Func)(GLsizei       n,
+                                               GLuint *      buffers);
+/* glDeleteBuffers */
+typedef void (APIENTRY * glDeleteBuffersARB_Func)(GLsizei       n,
+                                                  const GLuint* buffers);
+/* glBindBuffer */
+typedef void (APIENTRY * glBindBufferARB_Func)(GLenum        target,
+                                               GLuint        buffer);
+/* glBufferData */
+typedef void (APIENTRY * glBufferDataARB_Func)(GLenum        target,
+                                               GLsizeiptr    size,
+                                               const GLvoid* data,
+                                               GLenum        usage);
+/* glBufferSubData */
+typedef void (APIENTRY * glBufferSubDataARB_Func)(GLenum        target,
+                                                  GLintptr      offset,
+                                                  GLsizeiptr    size,
+                                                  const GLvoid* data);
+/* glMapBuffer */
+typedef GLvoid* (APIENTRY * glMapBufferARB_Func)(GLenum        target,
+                                                 GLenum        access);
+/* glUnmapBuffer */
+typedef GLboolean (APIENTRY * glUnmapBufferARB_Func)(GLenum        target);
+/*
+ * ARB_map_buffer_range is optional (core since OpenGL 3.0)
+ *
+ * glMapBufferRange */
+typedef GLvoid* (APIENTRY * glMapBufferRange_Func)(GLenum        target,
+                                                   GLintptr      offset,
+                                                   GLsizeiptr    length,
+                                                   GLbitfield    access);
+/*
+ * ARB_framebuffer_object is optional (core since OpenGL 3.0), only
+ * used for the render scale (see scale.h)
+ *
+ * glGenFramebuffers */
+typedef void (APIENTRY * glGenFramebuffers_Func)(GLsizei       n,
+                                                 GLuint *      framebuffers);
+/* glBindFramebuffer */
+typedef void (APIENTRY * glBindFramebuffer_Func)(GLenum        target,
+                                                 GLuint        framebuffer);
+/* glFramebufferTexture2D */
+typedef void (APIENTRY * glFramebufferTexture2D_Func)(GLenum        target,
+                                                      GLenum        attachment,
+                                                      GLenum        textarget,
+                                                      GLuint        texture,
+                                                      GLint         level);
+/* glCheckFramebufferStatus */
+typedef GLenum (APIENTRY * glCheckFramebufferStatus_Func)(GLenum        target);
+
+/*** OpenGL 3.3 core function pointers ***
+ *
+ * Only loaded for the core renderer (see glcore.h). The buffer
+ * object functions above are shared, loaded by their core names.
+ **/
+/* glGenVertexArrays */
+typedef void (APIENTRY * glGenVertexArrays_Func)(GLsizei       n,
+                                                 GLuint *      arrays);
+/* glBindVertexArray */
+typedef void (APIENTRY * glBindVertexArray_Func)(GLuint        array);
+/* glVertexAttribPointer */
+typedef void (APIENTRY * glVertexAttribPointer_Func)(GLuint        index,
+                                                     GLint         size,
+                                                     GLenum        type,
+                                                     GLboolean     normalized,
+                                                     GLsizei       stride,
+                                                     const GLvoid* pointer);
+/* glEnableVertexAttribArray */
+typedef void (APIENTRY * glEnableVertexAttribArray_Func)(GLuint        index);
+/* glDisableVertexAttribArray */
+typedef void (APIENTRY * glDisableVertexAttribArray_Func)(GLuint        index);
+/* glVertexAttribDivisor */
+typedef void (APIENTRY * glVertexAttribDivisor_Func)(GLuint        index,
+                                                     GLuint        divisor);
+/* glVertexAttrib4f */
+typedef void (APIENTRY * glVertexAttrib4f_Func)(GLuint        index,
+                                                GLfloat       x,
+                                                GLfloat       y,
+                                                GLfloat       z,
+                                                GLfloat       w);
+/* glDrawElementsInstanced */
+typedef void (APIENTRY * glDrawElementsInstanced_Func)(GLenum        mode,
+                                                       GLsizei       count,
+                                                       GLenum        type,
+                                                       const GLvoid* indices,
+                                                       GLsizei       primcount);
+/* glCreateShader */
+typedef GLuint (APIENTRY * glCreateShader_Func)(GLenum        type);
+/* glShaderSource */
+typedef void (APIENTRY * glShaderSource_Func)(GLuint        shader,
+                                              GLsizei       count,
+                                              const GLchar** string,
+                                              const GLint*  length);
+/* glCompileShader */
+typedef void (APIENTRY * glCompileShader_Func)(GLuint        shader);
+/* glGetShaderiv */
+typedef void (APIENTRY * glGetShaderiv_Func)(GLuint        shader,
+                                             GLenum        pname,
+                                             GLint*        params);
+/* glGetShaderInfoLog */
+typedef void (APIENTRY * glGetShaderInfoLog_Func)(GLuint        shader,
+                                                  GLsizei       bufsize,
+                                                  GLsizei*      length,
+                                                  GLchar*       infolog);
+/* glDeleteShader */
+typedef void (APIENTRY * glDeleteShader_Func)(GLuint        shader);
+/* glCreateProgram */
+typedef GLuint (APIENTRY * glCreateProgram_Func)(void);
+/* glAttachShader */
+typedef void (APIENTRY * glAttachShader_Func)(GLuint        program,
+                                              GLuint        shader);
+/* glLinkProgram */
+typedef void (APIENTRY * glLinkProgram_Func)(GLuint        program);
+/* glGetProgramiv */
+typedef void (APIENTRY * glGetProgramiv_Func)(GLuint        program,
+                                              GLenum        pname,
+                                              GLint*        params);
+/* glGetProgramInfoLog */
+typedef void (APIENTRY * glGetProgramInfoLog_Func)(GLuint        program,
+                                                   GLsizei       bufsize,
+                                                   GLsizei*      length,
+                                                   GLchar*       infolog);
+/* glUseProgram */
+typedef void (APIENTRY * glUseProgram_Func)(GLuint        program);
+/* glGetUniformLocation */
+typedef GLint (APIENTRY * glGetUniformLocation_Func)(GLuint        program,
+                                                     const GLchar* name);
+/* glUniform4f */
+typedef void (APIENTRY * glUniform4f_Func)(GLint         location,
+                                           GLfloat       x,
+                                           GLfloat       y,
+                                           GLfloat       z,
+                                           GLfloat       w);
+/* glUniform1i */
+typedef void (APIENTRY * glUniform1i_Func)(GLint         location,
+                                           GLint         x);
+/* glUniform2fv */
+typedef void (APIENTRY * glUniform2fv_Func)(GLint          location,
+                                            GLsizei        count,
+                                            const GLfloat* value);
+
+#ifndef MAIN_FILE_
+extern glGenBuffersARB_Func glGenBuffersARB_ptr;
+extern glDeleteBuffersARB_Func glDeleteBuffersARB_ptr;
+extern glBindBufferARB_Func glBindBufferARB_ptr;
+extern glBufferDataARB_Func glBufferDataARB_ptr;
+extern glBufferSubDataARB_Func glBufferSubDataARB_ptr;
+extern glMapBufferARB_Func glMapBufferARB_ptr;
+extern glUnmapBufferARB_Func glUnmapBufferARB_ptr;
+extern glMapBufferRange_Func glMapBufferRange_ptr;
+extern glGenFramebuffers_Func glGenFramebuffers_ptr;
+extern glBindFramebuffer_Func glBindFramebuffer_ptr;
+extern glFramebufferTexture2D_Func glFramebufferTexture2D_ptr;
+extern glCheckFramebufferStatus_Func glCheckFramebufferStatus_ptr;
+extern glGenVertexArrays_Func glGenVertexArrays_ptr;
+extern glBindVertexArray_Func glBindVertexArray_ptr;
+extern glVertexAttribPointer_Func glVertexAttribPointer_ptr;
+extern glEnableVertexAttribArray_Func glEnableVertexAttribArray_ptr;
+extern glDisableVertexAttribArray_Func glDisableVertexAttribArray_ptr;
+extern glVertexAttribDivisor_Func glVertexAttribDivisor_ptr;
+extern glVertexAttrib4f_Func glVertexAttrib4f_ptr;
+extern glDrawElementsInstanced_Func glDrawElementsInstanced_ptr;
+extern glCreateShader_Func glCreateShader_ptr;
+extern glShaderSource_Func glShaderSource_ptr;
+extern glCompileShader_Func glCompileShader_ptr;
+extern glGetShaderiv_Func glGetShaderiv_ptr;
+extern glGetShaderInfoLog_Func glGetShaderInfoLog_ptr;
+extern glDeleteShader_Func glDeleteShader_ptr;
+extern glCreateProgram_Func glCreateProgram_ptr;
+extern glAttachShader_Func glAttachShader_ptr;
+extern glLinkProgram_Func glLinkProgram_ptr;
+extern glGetProgramiv_Func glGetProgramiv_ptr;
+extern glGetProgramInfoLog_Func glGetProgramInfoLog_ptr;
+extern glUseProgram_Func glUseProgram_ptr;
+extern glGetUniformLocation_Func glGetUniformLocation_ptr;
+extern glUniform4f_Func glUniform4f_ptr;
+extern glUniform1i_Func glUniform1i_ptr;
+extern glUniform2fv_Func glUniform2fv_ptr;
+#else /*definitions*/
+glGenBuffersARB_Func glGenBuffersARB_ptr = 0;
+glDeleteBuffersARB_Func glDeleteBuffersARB_ptr = 0;
+glBindBufferARB_Func glBindBufferARB_ptr = 0;
+glBufferDataARB_Func glBufferDataARB_ptr = 0;
+glBufferSubDataARB_Func glBufferSubDataARB_ptr = 0;
+glMapBufferARB_Func glMapBufferARB_ptr = 0;
+glUnmapBufferARB_Func glUnmapBufferARB_ptr = 0;
+glMapBufferRange_Func glMapBufferRange_ptr = 0;
+glGenFramebuffers_Func glGenFramebuffers_ptr = 0;
+glBindFramebuffer_Func glBindFramebuffer_ptr = 0;
+glFramebufferTexture2D_Func glFramebufferTexture2D_ptr = 0;
+glCheckFramebufferStatus_Func glCheckFramebufferStatus_ptr = 0;
+glGenVertexArrays_Func glGenVertexArrays_ptr = 0;
+glBindVertexArray_Func glBindVertexArray_ptr = 0;
+glVertexAttribPointer_Func glVertexAttribPointer_ptr = 0;
+glEnableVertexAttribArray_Func glEnableVertexAttribArray_ptr = 0;
+glDisableVertexAttribArray_Func glDisableVertexAttribArray_ptr = 0;
+glVertexAttribDivisor_Func glVertexAttribDivisor_ptr = 0;
+glVertexAttrib4f_Func glVertexAttrib4f_ptr = 0;
+glDrawElementsInstanced_Func glDrawElementsInstanced_ptr = 0;
+glCreateShader_Func glCreateShader_ptr = 0;
+glShaderSource_Func glShaderSource_ptr = 0;
+glCompileShader_Func glCompileShader_ptr = 0;
+glGetShaderiv_Func glGetShaderiv_ptr = 0;
+glGetShaderInfoLog_Func glGetShaderInfoLog_ptr = 0;
+glDeleteShader_Func glDeleteShader_ptr = 0;
+glCreateProgram_Func glCreateProgram_ptr = 0;
+glAttachShader_Func glAttachShader_ptr = 0;
+glLinkProgram_Func glLinkProgram_ptr = 0;
+glGetProgramiv_Func glGetProgramiv_ptr = 0;
+glGetProgramInfoLog_Func glGetProgramInfoLog_ptr = 0;
+glUseProgram_Func glUseProgram_ptr = 0;
+glGetUniformLocation_Func glGetUniformLocation_ptr = 0;
+glUniform4f_Func glUniform4f_ptr = 0;
+glUniform1i_Func glUniform1i_ptr = 0;
+glUniform2fv_Func glUniform2fv_ptr = 0;
+#endif /*MAIN_FILE_*/
+#endif /*GLFUNC_H*/
@@ -44,14 +44,70 @@
 #define ASTEROIDS_VER_MINOR 5
 #define ASTEROIDS_VER_PATCH 2
 
-#define AUDIO_MIX_CHANNELS   8
-#define AUDIO_SAMPLE_RATE    8000
-#define AUDIO_CALLBACK_BYTES 256
+#define AUDIO_MIX_CHANNELS   8  /*default and least headroom, in channels*/
+#define AUDIO_VOICE_MAX      32 /*most channels the pool can be given*/
+#define AUDIO_SAMPLE_RATE    48000 /*default output rate*/
+#define AUDIO_RATE_MIN       8000 /*sound lengths are samples at this rate*/
+#define AUDIO_RATE_MAX       48000
+#define AUDIO_TICK_SAMPLES   256  /*sound recipes step once per this many*/
+#define AUDIO_TICK_MAX       (AUDIO_TICK_SAMPLES*AUDIO_RATE_MAX/AUDIO_RATE_MIN)
+#define AUDIO_QUEUE          32 /*sound commands waiting for the callback*/
+#define AUDIO_DELAY_MAX      800 /*longest a sound waits for its gap, in
+                                 *samples at AUDIO_RATE_MIN (100 ms)*/
+#define AUDIO_WAVE_BITS      10 /*log2 of the wavetable length*/
+#define AUDIO_WAVE_SIZE      (1 << AUDIO_WAVE_BITS)
+#define AUDIO_BENCH_SECONDS  10 /*audio rendered per pass of bench_audio()*/
+#define AUDIO_HIST_BINS      16 /*callback times, bin b is under 2^b us*/
 #define SFX_MAX_TUNES   0x1F
 #define SFX_TUNE(x)     ((x) < SFX_MAX_TUNES ? (x) : 0x00)
 #define SFX_PLAYER_HIT  SFX_MAX_TUNES + 1
 #define SFX_ASTER_HIT   SFX_MAX_TUNES + 2
-#define PLAYER_MAX      2
+#define SOUND_RESET      0 /*tune at the start of a round*/
+#define SOUND_PLAYER_HIT 1
+#define SOUND_ASTER_HIT  2
+#define SOUND_COUNT      3
+#define SOUND_VARIANTS   4 /*cached takes of sounds that use rand()*/
+#define SOUND_BURST      4 /*most starts of one sound per physics update*/
+#define PLAYER_MAX      8
+#define RENDERER_VBO    0 /*OpenGL 1.5, falls back to legacy*/
+#define RENDERER_LEGACY 1 /*OpenGL 1.1*/
+#define RENDERER_CORE   2 /*OpenGL 3.3 core, falls back to VBO*/
+#define RENDERER_SOFT   3 /*CPU rasterizer, no window or GL*/
+#define TEXT_MAX_CHARS  32
+#define STREAM_ALIGN    16 /*byte alignment of each stream write*/
+#define STREAM_FRAMES   4  /*frames of data the stream holds before orphaning*/
+#define SNAPSHOT_FRESH  0x4 /*set in st_render.middle until it is taken*/
+#define CAPTURE_PBOS    3  /*frames a capture readback stays behind*/
+#define CAPTURE_QUEUE   8  /*captured frames waiting to be encoded*/
+#define IDLE_WAIT_MS    250 /*longest sleep between checks while idle*/
+#define SCALE_MIN       0.25f /*smallest render scale*/
+#define SCALE_STEP      0.1f
+#define SCALE_WINDOW    30  /*frames averaged before an automatic change*/
+#define SCALE_TARGET_MS 17.0 /*automatic scale aims for about 60 fps*/
+#define SCALE_PROBE     20  /*steady windows before trying a larger scale*/
+#define PARTICLE_MAX    4096 /*pooled particles, more are dropped*/
+#define PARTICLE_DRAG   0.02f /*fraction of speed lost per frame*/
+#define ASTER_VARIANTS  8 /*asteroid shapes, the first one is hand-made*/
+#define ASTER_EDGES     8 /*outline points of every asteroid shape*/
+#define MESH_SPACE      0 /*empty, so a space is glyph 0*/
+#define MESH_PLAYER     1
+#define MESH_PROJECTILE 2 /*also the period glyph*/
+#define MESH_BLAST      3
+#define MESH_GLYPH      4 /*'0' to '9', then 'A' to 'Z'*/
+#define MESH_ASTER      (MESH_GLYPH + 36) /*one per asteroid variant*/
+#define MESH_COUNT      (MESH_ASTER + ASTER_VARIANTS)
+#define LIST_GLYPHS     MESH_COUNT /*legacy lists: meshes, then ' ' to 'Z'*/
+#define LIST_COUNT      (LIST_GLYPHS + 'Z' - ' ' + 1)
+#define HUD_PAUSE       0
+#define HUD_FPS         1
+#define HUD_MSPF        2
+#define HUD_GLDRAW      3 /*GL_STATS builds only*/
+#define HUD_GLSTATE     4
+#define HUD_AUDIOTIME   5
+#define HUD_AUDIOLATE   6
+#define HUD_SCORE(x)    (7 + (x)*2)
+#define HUD_HISCORE(x)  (8 + (x)*2)
+#define HUD_TEXT_COUNT  HUD_SCORE(PLAYER_MAX)
 #define true            '\x01'
 #define false           '\x00'
 #define ASTER_LARGE     5.f
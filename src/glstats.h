@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef GLSTATS_H
+#define GLSTATS_H
+
+/*** GL call counters ***
+ *
+ * Built with -DGL_STATS (part of DEBUGFLAGS), the GL entry points used
+ * for drawing are replaced by macros that bump a counter and then make
+ * the real call. A macro is not expanded inside its own body, so the
+ * inner call goes to the GL function or pointer of the same name.
+ * Include this after glfunc.h. Without GL_STATS this header is empty.
+ *
+ * draw_objects() moves the counts into gl_stats_frame at the start of
+ * every frame, and draw_hud() prints them under the fps indicator.
+ **/
+#ifdef GL_STATS
+
+typedef struct st_glstats {
+    unsigned long draws;  /*glDraw* calls*/
+    unsigned long verts;  /*vertices submitted, times instances, not lists*/
+    unsigned long matrix; /*fixed function matrix stack operations*/
+    unsigned long state;  /*buffer, array, program, and viewport changes*/
+} st_glstats;
+
+#ifndef MAIN_FILE_
+extern st_glstats gl_stats;       /*counts for the frame being drawn*/
+extern st_glstats gl_stats_frame; /*counts for the last finished frame*/
+#else
+st_glstats gl_stats       = {0, 0, 0, 0};
+st_glstats gl_stats_frame = {0, 0, 0, 0};
+#endif /*MAIN_FILE_*/
+
+#define GL_STATS_DRAW(n)  (gl_stats.draws++, \
+                           gl_stats.verts += (unsigned long)(n))
+#define GL_STATS_MATRIX   (gl_stats.matrix++)
+#define GL_STATS_STATE    (gl_stats.state++)
+
+/*draw calls*/
+#define glDrawArrays(m,f,n) \
+        (GL_STATS_DRAW(n), glDrawArrays(m,f,n))
+#define glDrawElements(m,n,t,i) \
+        (GL_STATS_DRAW(n), glDrawElements(m,n,t,i))
+#define glDrawElementsInstanced_ptr(m,n,t,i,c) \
+        (GL_STATS_DRAW((n)*(c)), glDrawElementsInstanced_ptr(m,n,t,i,c))
+
+#define glCallList(l) \
+        (GL_STATS_DRAW(0), glCallList(l))
+#define glCallLists(n,t,l) \
+        (gl_stats.draws += (unsigned long)(n), glCallLists(n,t,l))
+
+/*matrix stack*/
+#define glMatrixMode(m) \
+        (GL_STATS_MATRIX, glMatrixMode(m))
+#define glLoadIdentity() \
+        (GL_STATS_MATRIX, glLoadIdentity())
+#define glOrtho(l,r,b,t,n,f) \
+        (GL_STATS_MATRIX, glOrtho(l,r,b,t,n,f))
+#define glPushMatrix() \
+        (GL_STATS_MATRIX, glPushMatrix())
+#define glPopMatrix() \
+        (GL_STATS_MATRIX, glPopMatrix())
+#define glTranslatef(x,y,z) \
+        (GL_STATS_MATRIX, glTranslatef(x,y,z))
+#define glRotatef(a,x,y,z) \
+        (GL_STATS_MATRIX, glRotatef(a,x,y,z))
+#define glScalef(x,y,z) \
+        (GL_STATS_MATRIX, glScalef(x,y,z))
+
+/*state changes*/
+#define glViewport(x,y,w,h) \
+        (GL_STATS_STATE, glViewport(x,y,w,h))
+#define glEnableClientState(a) \
+        (GL_STATS_STATE, glEnableClientState(a))
+#define glInterleavedArrays(f,s,p) \
+        (GL_STATS_STATE, glInterleavedArrays(f,s,p))
+#define glVertexPointer(n,t,s,p) \
+        (GL_STATS_STATE, glVertexPointer(n,t,s,p))
+#define glBindBufferARB_ptr(t,b) \
+        (GL_STATS_STATE, glBindBufferARB_ptr(t,b))
+#define glBindFramebuffer_ptr(t,f) \
+        (GL_STATS_STATE, glBindFramebuffer_ptr(t,f))
+#define glBindVertexArray_ptr(a) \
+        (GL_STATS_STATE, glBindVertexArray_ptr(a))
+#define glUseProgram_ptr(p) \
+        (GL_STATS_STATE, glUseProgram_ptr(p))
+#define glUniform4f_ptr(l,x,y,z,w) \
+        (GL_STATS_STATE, glUniform4f_ptr(l,x,y,z,w))
+#define glVertexAttrib4f_ptr(i,x,y,z,w) \
+        (GL_STATS_STATE, glVertexAttrib4f_ptr(i,x,y,z,w))
+#define glVertexAttribPointer_ptr(i,n,t,b,s,p) \
+        (GL_STATS_STATE, glVertexAttribPointer_ptr(i,n,t,b,s,p))
+#define glEnableVertexAttribArray_ptr(i) \
+        (GL_STATS_STATE, glEnableVertexAttribArray_ptr(i))
+#define glDisableVertexAttribArray_ptr(i) \
+        (GL_STATS_STATE, glDisableVertexAttribArray_ptr(i))
+
+#endif /*GL_STATS*/
+#endif /*GLSTATS_H*/
@@ -47,28 +47,19 @@
 #include "global.h"
 #define MAIN_FILE_
 #include "objects.h"
+#include "glfunc.h"
+#include "glstats.h"
 #include "shared.h"
+#include "mesh.h"
 #include "audio.h"
-
-/*** GL extension function pointers ***
- *
- * So far, only ARB_vertex_buffer_object is needed,
- * which is available since OpenGL 1.5
- *
- * glGenBuffers */
-typedef void (APIENTRY * glGenBuffersARB_Func)(GLsizei       n,
-                                               GLuint *      buffers);
-/* glBindBuffer */
-typedef void (APIENTRY * glBindBufferARB_Func)(GLenum        target,
-                                               GLuint        buffer);
-/* glBufferData */
-typedef void (APIENTRY * glBufferDataARB_Func)(GLenum        target,
-                                               GLsizeiptr    size,
-                                               const GLvoid* data,
-                                               GLenum        usage);
-glGenBuffersARB_Func glGenBuffersARB_ptr = 0;
-glBindBufferARB_Func glBindBufferARB_ptr = 0;
-glBufferDataARB_Func glBufferDataARB_ptr = 0;
+#include "collision.h"
+#include "glcore.h"
+#include "stream.h"
+#include "renderthread.h"
+#include "softrender.h"
+#include "text.h"
+#include "scale.h"
+#include "particles.h"
 
 void print_sdl_version(void)
 {
@@ -85,117 +76,20 @@ void print_sdl_version(void)
             ver_link.major, ver_link.minor, ver_link.patch, SDL_GetRevision());
 }
 
-bool init_(st_shared *init)
+/* Create window and GL context.
+ *
+ *     init         - struct containing variables required for init
+ *     mode_current - returns the display mode that was set
+ *
+ * Only called by init_() when not running headless or in software.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool init_video(st_shared *init, SDL_DisplayMode *mode_current)
 {
-    int i,j,k;
-    unsigned        object_buffers[] = {0,0};
-    const float     rad_mod = M_PI/180.f;
-    SDL_DisplayMode mode_current;
     SDL_DisplayMode mode_target;
     SDL_DisplayMode mode_default = {0,800,600,0,0};
-    SDL_AudioSpec   spec_target, spec_current;
-
-    /*initialize players*/
-    /*reserve memory for config.player_count players*/
-    *init->plyr = (struct player*) malloc(sizeof(struct player) *
-            init->config->player_count);
-    *init->players_alive = init->config->player_count;
-    for(i = 0; i < init->config->player_count; i++)
-    {
-        (*init->plyr)[i].died        = false;
-        (*init->plyr)[i].blast_reset = true;
-        (*init->plyr)[i].key_forward = false;
-        (*init->plyr)[i].key_backward= false;
-        (*init->plyr)[i].key_left    = false;
-        (*init->plyr)[i].key_right   = false;
-        (*init->plyr)[i].key_shoot   = false;
-        (*init->plyr)[i].score       = 0;
-        (*init->plyr)[i].top_score   = 0;
-        (*init->plyr)[i].blast_scale = 1.f;
-        /*for now, position only accomodates 2 players*/
-        (*init->plyr)[i].pos[0]      = 0.f;
-        (*init->plyr)[i].pos[1]      = (float)(init->config->player_count - 1)*
-                                      ((float)(i) - 0.5f) * (-1.f);
-        (*init->plyr)[i].vel[0]      = 0.f;
-        (*init->plyr)[i].vel[1]      = 0.f;
-        (*init->plyr)[i].rot         = (float)i * 180.f;
-        for(j = 0; j < 6; j++)
-            (*init->plyr)[i].bounds[j]    = 0.f;
-        (*init->plyr)[i].shot.pos[0]      = 0.f;
-        (*init->plyr)[i].shot.pos[1]      = 0.f;
-        (*init->plyr)[i].shot.real_pos[0] = 0.f;
-        (*init->plyr)[i].shot.real_pos[1] = 0.f;
-    }
 
-    /*initialize asteroids*/
-    /*reserve memory for config.aster_max_count asteroids*/
-    *init->aster = (struct asteroid*) malloc(sizeof(struct asteroid) *
-            init->config->aster_max_count);
-    for(i = 0; i < init->config->aster_max_count; i++)
-    {
-        (*init->aster)[i].is_spawned = 0;
-        (*init->aster)[i].collided   = -1;
-        (*init->aster)[i].mass   = init->config->aster_mass_large * MASS_LARGE;
-        (*init->aster)[i].scale  = init->config->aster_scale * ASTER_LARGE;
-        (*init->aster)[i].pos[0]     = 1.f;
-        (*init->aster)[i].pos[1]     = 1.f;
-        (*init->aster)[i].vel[0]     = 0.f;
-        (*init->aster)[i].vel[1]     = 0.f;
-        (*init->aster)[i].angle      = 0.f;
-        (*init->aster)[i].rot        = 0.f;
-        (*init->aster)[i].rot_speed  = 0.f;
-        /*initialize asteroid bounding triangles*/
-        for(j = 0; j < 6; j++)
-        {
-            for(k = 0; k < 6; k++)
-                (*init->aster)[i].bounds_real[j][k] = 0.f;
-        }
-    }
-
-    if(SDL_Init(SDL_INIT_VIDEO|SDL_INIT_AUDIO))
-    {
-        fprintf(stderr, "SDL Init: %s\n", SDL_GetError());
-        return false;
-    }
-    /*audio init*/
-    if(init->config->audio_enabled)
-    {
-        (init->sfx_main)[0].volume = init->config->audio_volume;
-        spec_target.freq = AUDIO_SAMPLE_RATE;
-        spec_target.format = AUDIO_S8;
-        spec_target.channels = 1;
-        spec_target.samples = AUDIO_CALLBACK_BYTES;
-        spec_target.callback = audio_fill_buffer;
-        spec_target.userdata = init->sfx_main;
-        init->audio_device = SDL_OpenAudioDevice(NULL, 0, &spec_target,
-                                                 &spec_current, 0);
-        if(!init->audio_device)
-        {
-            fprintf(stderr, "SDL Open Audio: Failed to open audio device.\n");
-            init->config->audio_enabled = false;
-        }
-        else if(spec_current.format != spec_target.format)
-        {
-            fprintf(stderr, "Couldn't get AUDIO_S8. Instead got AUDIO_");
-            if(SDL_AUDIO_ISFLOAT(spec_current.format))
-                fprintf(stderr, "F");
-            else if(SDL_AUDIO_ISSIGNED(spec_current.format))
-                fprintf(stderr, "S");
-            else
-                fprintf(stderr, "U");
-            if(spec_current.format & 0x08)
-                fprintf(stderr, "8");
-            else if(spec_current.format & 0x10)
-                fprintf(stderr, "16");
-            else if(spec_current.format & 0x20)
-                fprintf(stderr, "32");
-            fprintf(stderr, "\n");
-            SDL_CloseAudioDevice(init->audio_device);
-            init->config->audio_enabled = false;
-        }
-    }
-    if(init->config->audio_enabled)
-        SDL_PauseAudioDevice(init->audio_device, 0);
     /*find closest mode*/
     if(init->config->fullscreen)
     {
@@ -213,29 +107,39 @@ bool init_(st_shared *init)
                 SDL_ClearError();
             }
         }
-        if(!(SDL_GetClosestDisplayMode(0, &mode_target, &mode_current)))
+        if(!(SDL_GetClosestDisplayMode(0, &mode_target, mode_current)))
         {
             fprintf(stderr, "SDL Get Display Mode: %s\n", SDL_GetError());
             SDL_ClearError();
-            mode_current = mode_default;
+            *mode_current = mode_default;
         }
     }
     else
     {
-        mode_target.w             = init->config->winres.width;
-        mode_target.h             = init->config->winres.height;
-        mode_target.refresh_rate  = init->config->winres.refresh;
-        mode_current.w            = init->config->winres.width;
-        mode_current.h            = init->config->winres.height;
-        mode_current.refresh_rate = init->config->winres.refresh;
+        mode_target.w              = init->config->winres.width;
+        mode_target.h              = init->config->winres.height;
+        mode_target.refresh_rate   = init->config->winres.refresh;
+        mode_current->w            = init->config->winres.width;
+        mode_current->h            = init->config->winres.height;
+        mode_current->refresh_rate = init->config->winres.refresh;
     }
 
+    /*ask for a 3.3 core profile, with a fallback once we try it*/
+    if(init->config->renderer == RENDERER_CORE)
+    {
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+        SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK,
+                            SDL_GL_CONTEXT_PROFILE_CORE);
+    }
     /*create window*/
     if(!(*init->win_main = SDL_CreateWindow("Simple Asteroids",
                                      SDL_WINDOWPOS_UNDEFINED,
                                      SDL_WINDOWPOS_UNDEFINED,
                                      mode_default.w,
                                      mode_default.h,
+                                     init->config->bench_frames ?
+                                     SDL_WINDOW_OPENGL|SDL_WINDOW_HIDDEN :
                                      SDL_WINDOW_OPENGL)))
     {
         fprintf(stderr, "SDL Create Window: %s\n", SDL_GetError());
@@ -244,7 +148,7 @@ bool init_(st_shared *init)
     /*set resolution*/
     if(init->config->fullscreen == 1)
     {
-        if(SDL_SetWindowDisplayMode(*init->win_main, &mode_current))
+        if(SDL_SetWindowDisplayMode(*init->win_main, mode_current))
         {
             fprintf(stderr, "SDL Set Display Mode: %s\n", SDL_GetError());
             SDL_ClearError();
@@ -262,13 +166,25 @@ bool init_(st_shared *init)
         {
             fprintf(stderr, "SDL Set Fullscreen: %s\n", SDL_GetError());
             SDL_ClearError();
-            SDL_SetWindowSize(*init->win_main, mode_current.w, mode_current.h);
+            SDL_SetWindowSize(*init->win_main,
+                              mode_current->w, mode_current->h);
         }
     }
     else
         SDL_SetWindowSize(*init->win_main, mode_target.w, mode_target.h);
     /*create GL context*/
-    if(!(*init->win_main_gl = SDL_GL_CreateContext(*init->win_main)))
+    *init->win_main_gl = SDL_GL_CreateContext(*init->win_main);
+    if(!*init->win_main_gl && init->config->renderer == RENDERER_CORE)
+    {
+        fprintf(stderr, "SDL GLContext: %s\nOpenGL 3.3 core not supported. Using OpenGL 1.5.\n",
+                SDL_GetError());
+        SDL_ClearError();
+        SDL_GL_ResetAttributes();
+        *init->win_main_gl = SDL_GL_CreateContext(*init->win_main);
+    }
+    else if(*init->win_main_gl && init->config->renderer == RENDERER_CORE)
+        init->core_context = true;
+    if(!*init->win_main_gl)
     {
         fprintf(stderr, "SDL GLContext: %s\n", SDL_GetError());
         return false;
@@ -303,16 +219,364 @@ bool init_(st_shared *init)
             SDL_ClearError();
         }
     }
-    /*get real screen size/bounds*/
-    SDL_GL_GetDrawableSize(*init->win_main,init->width_real,init->height_real);
+    return true;
+}
+
+/* Compile the static shapes into display lists.
+ *
+ *     init - struct containing variables required for init
+ *
+ * Only called by init_gl() for the legacy renderer, after the vertex
+ * array is set up. See the LIST_* defines for the layout. Each glyph
+ * list moves the modelview matrix one character to the right, so a
+ * whole string can be drawn with glCallLists(). glListBase() is set
+ * here for that and isn't changed afterwards.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool init_lists(st_shared *init)
+{
+    int      i;
+    int      glyph;
+    st_mesh *m;
+
+    if(!(init->gl_lists = glGenLists(LIST_COUNT)))
+        return false;
+    /*every mesh in the atlas*/
+    for(i = 0; i < MESH_COUNT; i++)
+    {
+        m = &mesh_atlas.mesh[i];
+        glNewList(init->gl_lists + i, GL_COMPILE);
+        if(m->count)
+            glDrawElements(m->mode, m->count, GL_UNSIGNED_SHORT,
+                    &mesh_atlas.index[m->first]);
+        glEndList();
+    }
+    /*characters from ' ' to 'Z', same layout as set_text()*/
+    for(i = ' '; i <= 'Z'; i++)
+    {
+        glNewList(init->gl_lists + LIST_GLYPHS + i - ' ', GL_COMPILE);
+        glyph = get_glyph((char)i);
+        if(glyph > 0)
+        {
+            m = &mesh_atlas.mesh[glyph];
+            if(glyph == MESH_PROJECTILE) /*period sits on the baseline*/
+                glTranslatef(0.f, -0.08f, 0.f);
+            glDrawElements(GL_LINE_STRIP, m->count, GL_UNSIGNED_SHORT,
+                    &mesh_atlas.index[m->first]);
+            if(glyph == MESH_PROJECTILE)
+                glTranslatef(0.f, 0.08f, 0.f);
+        }
+        glTranslatef(0.06f, 0.f, 0.f);
+        glEndList();
+    }
+    glListBase(init->gl_lists + LIST_GLYPHS - ' ');
+    return true;
+}
+
+/* Print GL info and set up vertex buffers.
+ *
+ *     init - struct containing variables required for init
+ *
+ * Only called by init_() once a GL context exists. If the core
+ * renderer can't be set up, the context is replaced with a
+ * default one and the OpenGL 1.5 path is used instead.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool init_gl(st_shared *init)
+{
+    printf("\n\nOpenGL version: %s\n\
+       shader: %s\n\
+       vendor: %s\n\
+       renderer: %s\n**********\n",
+       glGetString(GL_VERSION),
+       glGetString(GL_SHADING_LANGUAGE_VERSION),
+       glGetString(GL_VENDOR),
+       glGetString(GL_RENDERER));
+    /*HUD strings, built on first draw*/
+    init->hud = (st_text*) calloc(HUD_TEXT_COUNT, sizeof(st_text));
+    init->capture = (st_capture*) calloc(1, sizeof(st_capture));
+    if(init->core_context && !init_core(init))
+    {
+        fprintf(stderr, "OpenGL 3.3 core renderer failed. Using OpenGL 1.5.\n");
+        init->core_context = false;
+        SDL_GL_DeleteContext(*init->win_main_gl);
+        SDL_GL_ResetAttributes();
+        if(!(*init->win_main_gl = SDL_GL_CreateContext(*init->win_main)))
+        {
+            fprintf(stderr, "SDL GLContext: %s\n", SDL_GetError());
+            return false;
+        }
+        SDL_GL_SetSwapInterval(init->config->vsync);
+    }
+    /*fetch GL extension functions, core ones come from init_core()*/
+    if(init->core_context)
+        printf("Using OpenGL 3.3 core renderer.\n");
+    else if(init->config->renderer == RENDERER_LEGACY)
+        init->legacy_context = true;
+    else if(!SDL_GL_ExtensionSupported("GL_ARB_vertex_buffer_object"))
+    {
+        fprintf(stderr, "GL_ARB_vertex_buffer_object not supported. Using OpenGL 1.1 legacy context.\n");
+        init->legacy_context = true;
+    }
+    else
+    {
+        *(void **) (&glGenBuffersARB_ptr) =
+            SDL_GL_GetProcAddress("glGenBuffersARB");
+        *(void **) (&glDeleteBuffersARB_ptr) =
+            SDL_GL_GetProcAddress("glDeleteBuffersARB");
+        *(void **) (&glBindBufferARB_ptr) =
+            SDL_GL_GetProcAddress("glBindBufferARB");
+        *(void **) (&glBufferDataARB_ptr) =
+            SDL_GL_GetProcAddress("glBufferDataARB");
+        *(void **) (&glBufferSubDataARB_ptr) =
+            SDL_GL_GetProcAddress("glBufferSubDataARB");
+        *(void **) (&glMapBufferARB_ptr) =
+            SDL_GL_GetProcAddress("glMapBufferARB");
+        *(void **) (&glUnmapBufferARB_ptr) =
+            SDL_GL_GetProcAddress("glUnmapBufferARB");
+        if(SDL_GL_ExtensionSupported("GL_ARB_map_buffer_range"))
+            *(void **) (&glMapBufferRange_ptr) =
+                SDL_GL_GetProcAddress("glMapBufferRange");
+    }
+    if(!init->legacy_context)
+    {
+        /*** Buffer Objects ***/
+        glGenBuffersARB_ptr(3, init->gl_buffers);
+        glBindBufferARB_ptr(GL_ARRAY_BUFFER, init->gl_buffers[0]);
+        glBufferDataARB_ptr(GL_ARRAY_BUFFER,
+                sizeof(float)*2*mesh_atlas.vert_count,
+                mesh_atlas.verts, GL_STATIC_DRAW);
+        glBindBufferARB_ptr(GL_ELEMENT_ARRAY_BUFFER, init->gl_buffers[1]);
+        glBufferDataARB_ptr(GL_ELEMENT_ARRAY_BUFFER,
+                sizeof(unsigned short)*mesh_atlas.index_count,
+                mesh_atlas.index, GL_STATIC_DRAW);
+    }
+    if(init->core_context)
+    {
+        /*static vertices are attribute 0 of the VAO*/
+        glVertexAttribPointer_ptr(0, 2, GL_FLOAT, GL_FALSE, 0,
+                (void*)(intptr_t)(0));
+        /*one instance per asteroid, plus 2 per player (ship and
+         *projectile, or both blast rings), then asteroid variants*/
+        init->aster_batch = (float*) malloc(sizeof(float) *
+            (5*init->config->aster_max_count + 8*init->config->player_count));
+        init_stream(&init->stream, init->gl_buffers[2], GL_ARRAY_BUFFER,
+                sizeof(float) * STREAM_FRAMES * (2*PARTICLE_MAX +
+            5*init->config->aster_max_count + 8*init->config->player_count));
+        glBindBufferARB_ptr(GL_ARRAY_BUFFER, init->gl_buffers[0]);
+    }
+    else if(!init->legacy_context)
+    {
+        glInterleavedArrays(GL_V2F, 0, (void*)(intptr_t)(0));
+        /*every asteroid outline as GL_LINES, filled each frame*/
+        init->aster_batch = (float*) malloc(sizeof(float) * 4 *
+                ASTER_EDGES * init->config->aster_max_count);
+        init_stream(&init->stream, init->gl_buffers[2], GL_ARRAY_BUFFER,
+                sizeof(float) * STREAM_FRAMES * (2*PARTICLE_MAX + 4 *
+                ASTER_EDGES * init->config->aster_max_count));
+        glBindBufferARB_ptr(GL_ARRAY_BUFFER, init->gl_buffers[0]);
+    }
+    else
+    {
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(2, GL_FLOAT, 0, mesh_atlas.verts);
+        /*keep the static geometry on the GL side*/
+        if(!init_lists(init))
+        {
+            fprintf(stderr, "Display lists failed. Using vertex arrays.\n");
+            init->gl_lists = 0;
+        }
+    }
+    /*particles, streamed or drawn from client memory as points*/
+    init->particle_batch = (float*) malloc(sizeof(float) * 2 * PARTICLE_MAX);
+    glPointSize(2.f);
+    init_scale(init);
+    return init->particle_batch != NULL;
+}
+
+bool init_(st_shared *init)
+{
+    int i,j,k;
+    const float     rad_mod = M_PI/180.f;
+    SDL_DisplayMode mode_current;
+    SDL_AudioSpec   spec_target, spec_current;
+    /*the software renderer needs neither a window nor GL*/
+    const bool      windowless = init->config->headless ||
+                                 init->config->renderer == RENDERER_SOFT;
+
+    /*pack every shape into one set of arrays*/
+    if(!init_atlas())
+        return false;
+
+    /*initialize players*/
+    /*reserve memory for config.player_count players*/
+    *init->plyr = (struct player*) malloc(sizeof(struct player) *
+            init->config->player_count);
+    *init->players_alive = init->config->player_count;
+    for(i = 0; i < init->config->player_count; i++)
+    {
+        (*init->plyr)[i].died        = false;
+        (*init->plyr)[i].blast_reset = true;
+        (*init->plyr)[i].key_forward = false;
+        (*init->plyr)[i].key_backward= false;
+        (*init->plyr)[i].key_left    = false;
+        (*init->plyr)[i].key_right   = false;
+        (*init->plyr)[i].key_shoot   = false;
+        (*init->plyr)[i].score       = 0;
+        (*init->plyr)[i].top_score   = 0;
+        (*init->plyr)[i].blast_scale = 1.f;
+        (*init->plyr)[i].exhaust     = 0.f;
+        get_player_spawn(i, init->config->player_count,
+                         (*init->plyr)[i].pos, &(*init->plyr)[i].rot);
+        (*init->plyr)[i].vel[0]      = 0.f;
+        (*init->plyr)[i].vel[1]      = 0.f;
+        for(j = 0; j < 6; j++)
+            (*init->plyr)[i].bounds[j]    = 0.f;
+        (*init->plyr)[i].shot.pos[0]      = 0.f;
+        (*init->plyr)[i].shot.pos[1]      = 0.f;
+        (*init->plyr)[i].shot.real_pos[0] = 0.f;
+        (*init->plyr)[i].shot.real_pos[1] = 0.f;
+    }
+
+    /*initialize asteroids*/
+    /*reserve memory for config.aster_max_count asteroids*/
+    *init->aster = (struct asteroid*) malloc(sizeof(struct asteroid) *
+            init->config->aster_max_count);
+    /*free pool can hold every asteroid*/
+    *init->aster_free = (int*) malloc(sizeof(int) *
+            init->config->aster_max_count);
+    for(i = 0; i < init->config->aster_max_count; i++)
+    {
+        (*init->aster)[i].is_spawned = 0;
+        (*init->aster)[i].collided   = -1;
+        (*init->aster)[i].variant    = 0;
+        (*init->aster)[i].mass   = init->config->aster_mass_large * MASS_LARGE;
+        (*init->aster)[i].scale  = init->config->aster_scale * ASTER_LARGE;
+        (*init->aster)[i].pos[0]     = 1.f;
+        (*init->aster)[i].pos[1]     = 1.f;
+        (*init->aster)[i].vel[0]     = 0.f;
+        (*init->aster)[i].vel[1]     = 0.f;
+        (*init->aster)[i].angle      = 0.f;
+        (*init->aster)[i].rot        = 0.f;
+        (*init->aster)[i].rot_speed  = 0.f;
+        /*initialize asteroid bounding triangles*/
+        for(j = 0; j < ASTER_EDGES; j++)
+        {
+            for(k = 0; k < 6; k++)
+                (*init->aster)[i].bounds_real[j][k] = 0.f;
+        }
+    }
+
+    /*initialize particles*/
+    if(!init_particles(init->particles))
+    {
+        fprintf(stderr, "Could not allocate particles.\n");
+        return false;
+    }
+
+    /*benchmark in a hidden window, as fast as the renderer allows*/
+    if(init->config->bench_frames)
+    {
+        init->config->audio_enabled = false;
+        init->config->fullscreen    = 0;
+        init->config->vsync         = 0;
+        /*no display needed, SDL_VIDEODRIVER still takes precedence*/
+        if(!windowless)
+            SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+    }
+    if(SDL_Init(windowless ? SDL_INIT_EVENTS|SDL_INIT_TIMER :
+                             SDL_INIT_VIDEO|SDL_INIT_AUDIO))
+    {
+        if(!init->config->bench_frames || windowless)
+        {
+            fprintf(stderr, "SDL Init: %s\n", SDL_GetError());
+            return false;
+        }
+        /*SDL older than 2.0.12 has no offscreen driver*/
+        fprintf(stderr, "SDL Init: %s\nTrying the default video driver.\n",
+                SDL_GetError());
+        SDL_ClearError();
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "");
+        if(SDL_Init(SDL_INIT_VIDEO))
+        {
+            fprintf(stderr, "SDL Init: %s\n", SDL_GetError());
+            return false;
+        }
+    }
+    /*audio init*/
+    init_mixer(init->mixer, init->config->audio_volume,
+               init->config->audio_rate, init->config->audio_voices);
+    if(windowless)
+        init->config->audio_enabled = false;
+    if(init->config->audio_enabled && !cache_sounds(init->mixer))
+        init->config->audio_enabled = false;
+    if(init->config->audio_enabled)
+    {
+        spec_target.freq = init->mixer->rate;
+        spec_target.format = AUDIO_F32SYS;
+        spec_target.channels = 1;
+        /*about one sound tick per callback*/
+        for(spec_target.samples = AUDIO_TICK_SAMPLES;
+            spec_target.samples*2 <= init->mixer->tick_frames;
+            spec_target.samples *= 2);
+        spec_target.callback = audio_fill_buffer;
+        spec_target.userdata = init->mixer;
+        /*take the device's own format if the mixer can write it*/
+        init->audio_device = SDL_OpenAudioDevice(NULL, 0, &spec_target,
+                &spec_current, SDL_AUDIO_ALLOW_FORMAT_CHANGE);
+        if(init->audio_device &&
+                !mixer_format(init->mixer, spec_current.format))
+        {
+            /*otherwise SDL converts from floats*/
+            SDL_CloseAudioDevice(init->audio_device);
+            init->audio_device = SDL_OpenAudioDevice(NULL, 0, &spec_target,
+                                                     &spec_current, 0);
+            mixer_format(init->mixer, spec_target.format);
+        }
+        if(!init->audio_device)
+        {
+            fprintf(stderr, "SDL Open Audio: Failed to open audio device.\n");
+            init->config->audio_enabled = false;
+        }
+    }
+    if(init->config->audio_enabled)
+        SDL_PauseAudioDevice(init->audio_device, 0);
+    if(!windowless)
+    {
+        if(!init_video(init, &mode_current))
+            return false;
+        /*get real screen size/bounds*/
+        SDL_GL_GetDrawableSize(*init->win_main,
+                               init->width_real, init->height_real);
+    }
+    else /*no window, bounds follow the windowed resolution*/
+    {
+        *init->win_main    = NULL;
+        *init->width_real  = init->config->winres.width;
+        *init->height_real = init->config->winres.height;
+        mode_current.refresh_rate = 0;
+    }
     *init->left_clip   = *init->left_clip   * (*init->width_real/600.f);
     *init->right_clip  = *init->right_clip  * (*init->width_real/600.f);
     *init->top_clip    = *init->top_clip    * (*init->height_real/600.f);
     *init->bottom_clip = *init->bottom_clip * (*init->height_real/600.f);
     /*print info*/
     print_sdl_version();
-    printf("\nDisplay: %dx%d @%dHz", *init->width_real, *init->height_real,
-            mode_current.refresh_rate);
+    if(init->config->headless)
+        printf("\nDisplay: headless %dx%d",
+                *init->width_real, *init->height_real);
+    else if(windowless)
+        printf("\nDisplay: software %dx%d",
+                *init->width_real, *init->height_real);
+    else if(init->config->bench_frames)
+        printf("\nDisplay: %s %dx%d, benchmarking %u frames",
+                SDL_GetCurrentVideoDriver(), *init->width_real,
+                *init->height_real, init->config->bench_frames);
+    else
+        printf("\nDisplay: %dx%d @%dHz", *init->width_real,
+                *init->height_real, mode_current.refresh_rate);
     if(init->config->audio_enabled)
     {
         printf("\n\nAudio  sample rate: %d\n\
@@ -336,51 +600,28 @@ bool init_(st_shared *init)
     }
     else
         printf("\n\nAudio  disabled");
-    printf("\n\nOpenGL version: %s\n\
-       shader: %s\n\
-       vendor: %s\n\
-       renderer: %s\n**********\n",
-       glGetString(GL_VERSION),
-       glGetString(GL_SHADING_LANGUAGE_VERSION),
-       glGetString(GL_VENDOR),
-       glGetString(GL_RENDERER));
-    /*fetch GL extension functions*/
-    if(!SDL_GL_ExtensionSupported("GL_ARB_vertex_buffer_object"))
+    if(!windowless)
     {
-        fprintf(stderr, "GL_ARB_vertex_buffer_object not supported. Using OpenGL 1.1 legacy context.\n");
-        init->legacy_context = true;
-    }
-    if(!init->legacy_context)
-    {
-        *(void **) (&glGenBuffersARB_ptr) =
-            SDL_GL_GetProcAddress("glGenBuffersARB");
-        *(void **) (&glBindBufferARB_ptr) =
-            SDL_GL_GetProcAddress("glBindBufferARB");
-        *(void **) (&glBufferDataARB_ptr) =
-            SDL_GL_GetProcAddress("glBufferDataARB");
-        /*** Buffer Objects ***/
-        glGenBuffersARB_ptr(2, object_buffers);
-        glBindBufferARB_ptr(GL_ARRAY_BUFFER, object_buffers[0]);
-        glBufferDataARB_ptr(GL_ARRAY_BUFFER, sizeof(object_verts),
-                object_verts, GL_STATIC_DRAW);
-        glBindBufferARB_ptr(GL_ELEMENT_ARRAY_BUFFER, object_buffers[1]);
-        glBufferDataARB_ptr(GL_ELEMENT_ARRAY_BUFFER, sizeof(object_index),
-                object_index, GL_STATIC_DRAW);
-        glInterleavedArrays(GL_V2F, 0, (void*)(intptr_t)(0));
+        if(!init_gl(init))
+            return false;
     }
     else
     {
-        glEnableClientState(GL_VERTEX_ARRAY);
-        glVertexPointer(2, GL_FLOAT, 0, object_verts);
+        printf("\n**********\n");
+        if(!init->config->headless && !init_soft(init))
+            return false;
     }
-
-    /*set RNG and spawn 3 asteroids*/
-    srand((unsigned)time(NULL));
+    /*set RNG and spawn 3 asteroids, benchmarks replay the same game*/
+    if(init->config->bench_frames)
+        srand(1);
+    else
+        srand((unsigned)time(NULL));
     for(i = 0; i < (*init->config).aster_init_count &&
                i < (*init->config).aster_max_count; i++)
     {
         (*init->aster)[i].is_spawned = 1;
         (*init->aster)[i].collided   = -1;
+        (*init->aster)[i].variant    = rand() % ASTER_VARIANTS;
         if(rand() & 0x01)      /*50%*/
         {
             (*init->aster)[i].mass   = (*init->config).aster_mass_small *
@@ -413,24 +654,16 @@ bool init_(st_shared *init)
                                         cos((*init->aster)[i].angle*rad_mod);
         (*init->aster)[i].rot_speed  = ((rand()%400)-200)*0.01f;
     }
+    aster_pool_reset(init);
     /*get time in milliseconds*/
     *init->prev_timer = SDL_GetTicks();
     /*play reset tune*/
     if(init->config->audio_enabled)
-    {
-        (init->sfx_main)[0].sfx_nr   = SFX_TUNE(0);
-        (init->sfx_main)[0].note_nr  = 0;
-        (init->sfx_main)[0].i        = 0;
-        (init->sfx_main)[0].waveform = 2;
-        (init->sfx_main)[0].amp      = 1.f;
-        (init->sfx_main)[0].freq     = 1.f;
-        (init->sfx_main)[0].env      = 1.f;
-        (init->sfx_main)[0].attack   = 0;
-        (init->sfx_main)[0].decay    = 0;
-        (init->sfx_main)[0].sustain  = AUDIO_CALLBACK_BYTES*100;
-        (init->sfx_main)[0].release  = 0;
-        (init->sfx_main)[0].silence  = false;
-    }
+        play_sound(init->mixer, SOUND_RESET);
+    /*benchmarks time draw_objects() on the main thread*/
+    if(init->config->render_thread && !windowless &&
+            !init->config->bench_frames && !start_render_thread(init))
+        fprintf(stderr, "Render thread failed. Drawing on the main thread.\n");
     return true;
 }
 
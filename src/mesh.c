@@ -0,0 +1,170 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifdef _WIN32
+  #include <Windows.h>
+#endif
+#ifdef __APPLE__
+  #include <Carbon/Carbon.h>
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+#include <SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "objects.h"
+#include "global.h"
+#include "shared.h"
+#include "mesh.h"
+
+/* Get the next number from the variant generator.
+ *
+ *     seed - generator state
+ *
+ * A plain LCG, kept apart from rand() so the shapes don't depend
+ * on the game's random sequence.
+ *
+ * Returns a number between 0 and 1.
+ **/
+float mesh_random(unsigned long *seed)
+{
+    *seed = (*seed * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+    return (float)((*seed >> 16) & 0x7FFF) / 32767.f;
+}
+
+/* Make an asteroid outline.
+ *
+ *     seed    - generator state
+ *     outline - ASTER_EDGES x,y pairs to fill
+ *
+ * Points go clockwise from the top, evenly spaced with some jitter,
+ * at a distance from the center around that of the hand-made shape.
+ * Each point stays in its own slice, so the outline never crosses
+ * itself and the center can see every edge.
+ **/
+void mesh_aster_outline(unsigned long *seed, float *outline)
+{
+    int         k;
+    const float slice   = 360.f / ASTER_EDGES;
+    const float rad_mod = M_PI/180.f;
+    float       angle, radius;
+
+    for(k = 0; k < ASTER_EDGES; k++)
+    {
+        angle  = (k + (mesh_random(seed) - 0.5f)*0.6f) * slice * rad_mod;
+        radius = 0.025f + mesh_random(seed)*0.017f;
+        outline[k*2]   = radius * sin(angle);
+        outline[k*2+1] = radius * cos(angle);
+    }
+}
+
+bool init_atlas(void)
+{
+    int             i,k,v;
+    int             m     = 0;
+    int             first = 0;
+    unsigned long   seed  = 0x5EED;
+    float           outline[ASTER_EDGES*2];
+    st_atlas       *atlas = &mesh_atlas;
+
+    atlas->verts = (float*) malloc(sizeof(float) * 2 *
+            (OBJECT_VERTS + ASTER_VARIANTS*ASTER_EDGES));
+    atlas->index = (unsigned short*) malloc(sizeof(unsigned short) *
+            (OBJECT_INDICES + ASTER_VARIANTS*ASTER_EDGES));
+    if(!atlas->verts || !atlas->index)
+    {
+        fprintf(stderr, "Could not allocate the mesh atlas.\n");
+        return false;
+    }
+    for(i = 0; i < OBJECT_VERTS*2; i++)
+        atlas->verts[i] = object_verts[i];
+    atlas->vert_count = OBJECT_VERTS;
+    /*hand-made meshes, up to and including the first asteroid*/
+    atlas->mesh[0].first = 0;
+    for(i = 0; i < OBJECT_INDICES && m <= MESH_ASTER; i++)
+    {
+        if(object_index[i] != OBJECT_END)
+        {
+            atlas->index[first++] = object_index[i];
+            continue;
+        }
+        atlas->mesh[m].count = first - atlas->mesh[m].first;
+        if(++m <= MESH_ASTER)
+            atlas->mesh[m].first = first;
+    }
+    if(m <= MESH_ASTER || atlas->mesh[MESH_ASTER].count != ASTER_EDGES)
+    {
+        fprintf(stderr, "Mesh tables don't match the MESH_* layout.\n");
+        return false;
+    }
+    for(m = 0; m < MESH_COUNT; m++)
+    {
+        if(m == MESH_PLAYER || m >= MESH_ASTER)
+            atlas->mesh[m].mode = GL_LINE_LOOP;
+        else if(m >= MESH_GLYPH)
+            atlas->mesh[m].mode = GL_LINE_STRIP;
+        else
+            atlas->mesh[m].mode = GL_LINES;
+    }
+    /*asteroids, the hand-made outline is copied like the others*/
+    first = atlas->mesh[MESH_ASTER].first;
+    for(v = 0; v < ASTER_VARIANTS; v++)
+    {
+        if(v)
+            mesh_aster_outline(&seed, outline);
+        else
+        {
+            for(k = 0; k < ASTER_EDGES; k++)
+            {
+                outline[k*2]   = object_verts[atlas->index[first+k]*2];
+                outline[k*2+1] = object_verts[atlas->index[first+k]*2+1];
+            }
+        }
+        atlas->mesh[MESH_ASTER+v].first = first;
+        atlas->mesh[MESH_ASTER+v].count = ASTER_EDGES;
+        for(k = 0; k < ASTER_EDGES; k++)
+        {
+            atlas->verts[atlas->vert_count*2]   = outline[k*2];
+            atlas->verts[atlas->vert_count*2+1] = outline[k*2+1];
+            atlas->index[first++] = (unsigned short) atlas->vert_count++;
+            /*center, this point, next point*/
+            atlas->aster_bounds[v][k][0] = 0.f;
+            atlas->aster_bounds[v][k][1] = 0.f;
+            atlas->aster_bounds[v][k][2] = outline[k*2];
+            atlas->aster_bounds[v][k][3] = outline[k*2+1];
+            atlas->aster_bounds[v][k][4] = outline[((k+1)%ASTER_EDGES)*2];
+            atlas->aster_bounds[v][k][5] = outline[((k+1)%ASTER_EDGES)*2+1];
+        }
+    }
+    atlas->index_count = first;
+    return true;
+}
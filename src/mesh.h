@@ -0,0 +1,63 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef MESH_H
+#define MESH_H
+
+#include "shared.h"
+
+/*** mesh atlas ***
+ *
+ * Defined in init.c, read-only once init_atlas() has run.
+ **/
+#ifndef MAIN_FILE_
+extern st_atlas mesh_atlas;
+#else
+st_atlas mesh_atlas;
+#endif /*MAIN_FILE_*/
+
+/* Build the mesh atlas.
+ *
+ * Packs every hand-made mesh from objects.h into mesh_atlas with
+ * 16-bit indices, working out where each one starts from the
+ * OBJECT_END markers. Then generates ASTER_VARIANTS - 1 asteroid
+ * shapes around the hand-made one. Asteroid vertices are stored
+ * back to back, ASTER_EDGES per variant, each variant's outline
+ * going clockwise around the center. Their collision triangles
+ * are fanned out from the center into mesh_atlas.aster_bounds.
+ *
+ * Variants come from a fixed seed, so every run and every renderer
+ * gets the same shapes.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool init_atlas             (void);
+
+#endif /*MESH_H*/
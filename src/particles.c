@@ -0,0 +1,130 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#include <SDL.h>
+#include <math.h>
+#include <stdlib.h>
+#include "global.h"
+#include "shared.h"
+#include "particles.h"
+
+bool init_particles(st_particles *p)
+{
+    float *block;
+
+    /*one block, split into the per-field arrays*/
+    block = (float*) malloc(sizeof(float) * 5 * PARTICLE_MAX);
+    if(!block)
+        return false;
+    p->count = 0;
+    p->x     = block;
+    p->y     = block + PARTICLE_MAX;
+    p->vx    = block + PARTICLE_MAX*2;
+    p->vy    = block + PARTICLE_MAX*3;
+    p->life  = block + PARTICLE_MAX*4;
+    return true;
+}
+
+void emit_particles(st_particles *p,
+                    const int     count,
+                    const float  *pos,
+                    const float  *vel,
+                    const float   dir,
+                    const float   spread,
+                    const float   speed,
+                    const float   life)
+{
+    int         i,k;
+    const float rad_mod = M_PI/180.f;
+    float       angle, s;
+
+    for(k = 0; k < count && p->count < PARTICLE_MAX; k++)
+    {
+        i       = p->count++;
+        angle   = (dir + spread*((rand()%1000)*0.001f - 0.5f)) * rad_mod;
+        s       = speed * (0.2f + (rand()%800)*0.001f);
+        p->x[i]    = pos[0];
+        p->y[i]    = pos[1];
+        p->vx[i]   = vel[0] + s*sin(angle);
+        p->vy[i]   = vel[1] + s*cos(angle);
+        p->life[i] = life * (0.5f + (rand()%500)*0.001f);
+    }
+}
+
+void update_particles(st_particles *p, const float step)
+{
+    int         i;
+    int         count = p->count;
+    const float drag  = 1.f - PARTICLE_DRAG*step;
+    float      *x     = p->x;
+    float      *y     = p->y;
+    float      *vx    = p->vx;
+    float      *vy    = p->vy;
+    float      *life  = p->life;
+
+    /*no branches or calls, so this vectorizes*/
+    for(i = 0; i < count; i++)
+    {
+        x[i]    += vx[i] * step;
+        y[i]    += vy[i] * step;
+        vx[i]   *= drag;
+        vy[i]   *= drag;
+        life[i] -= step;
+    }
+    /*fill each expired slot with the last particle, keeping the
+     *live ones packed at the front*/
+    for(i = 0; i < count;)
+    {
+        if(life[i] > 0.f)
+        {
+            i++;
+            continue;
+        }
+        count--;
+        x[i]    = x[count];
+        y[i]    = y[count];
+        vx[i]   = vx[count];
+        vy[i]   = vy[count];
+        life[i] = life[count];
+    }
+    p->count = count;
+}
+
+int batch_particles(const st_particles *p, float *out)
+{
+    int i;
+
+    for(i = 0; i < p->count; i++)
+    {
+        out[i*2]   = p->x[i];
+        out[i*2+1] = p->y[i];
+    }
+    return p->count;
+}
@@ -0,0 +1,88 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "shared.h"
+
+/* Set up the particle pool.
+ *
+ *     p - pool to set up
+ *
+ * Allocates every array for PARTICLE_MAX particles up front, so
+ * nothing is allocated while the game runs.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool init_particles         (st_particles *p);
+
+/* Add particles to the pool.
+ *
+ *     p      - pool to add to
+ *     count  - number of particles
+ *     pos    - {x,y} vector where they start
+ *     vel    - {x,y} velocity they inherit
+ *     dir    - direction they fly off in, degrees
+ *     spread - width of the cone around 'dir', 360 for a ring
+ *     speed  - fastest speed away from 'pos', per frame
+ *     life   - longest lifetime in frames
+ *
+ * Speed and lifetime are randomized below the given values.
+ * Particles that don't fit in the pool are dropped.
+ **/
+void emit_particles         (st_particles *p,
+                             const int     count,
+                             const float  *pos,
+                             const float  *vel,
+                             const float   dir,
+                             const float   spread,
+                             const float   speed,
+                             const float   life);
+
+/* Move particles and drop expired ones.
+ *
+ *     p    - pool to update
+ *     step - time step, 1 is one 60 Hz frame
+ **/
+void update_particles       (st_particles *p,
+                             const float   step);
+
+/* Copy particle positions out for drawing.
+ *
+ *     p   - pool to read
+ *     out - x,y pairs, room for PARTICLE_MAX
+ *
+ * Returns the number of points written.
+ **/
+int batch_particles         (const st_particles *p,
+                             float              *out);
+
+#endif /*PARTICLES_H*/
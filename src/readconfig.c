@@ -64,12 +64,24 @@ void print_usage(void)
     printf("        -A         Disables audio playback.\n");
     printf("        -b  SCALE  Sets asteroid size modifier. 'SCALE' is a number\n");
     printf("                   between 0.5 and 2. The default scale is 1.\n");
+    printf("        -B  SLOT   Makes player 'SLOT' computer controlled. 'SLOT' is an\n");
+    printf("                   integer from 1 to %d. Can be given more than once.\n", PLAYER_MAX);
+    printf("        -c  COUNT  Sets number of fragments a hit asteroid splits into.\n");
+    printf("                   'COUNT' is an integer from 1 to 8. The default is 2.\n");
+    printf("        -C  FILE   Records video to 'FILE' in Y4M format from the start.\n");
+    printf("                   Recording can also be toggled with the capture key.\n");
     printf("        -d         Disables asteroid collision physics.\n");
     printf("        -f  STATE  Enables or disables friendly fire. 'STATE' can be\n");
     printf("                   on or off. The default is on.\n");
     printf("        -F  STATE  Enables or disables fullscreen mode. 'STATE' can be\n");
     printf("                   on, off, or desktop. The default is off.\n");
+    printf("        -g  GL     Sets the renderer. 'GL' can be vbo (OpenGL 1.5),\n");
+    printf("                   legacy (OpenGL 1.1), core (OpenGL 3.3 with\n");
+    printf("                   shaders), or soft (CPU only, no window, simulated\n");
+    printf("                   clock). The default is vbo.\n");
     printf("        -h         Print this help text and exit.\n");
+    printf("        -H         Headless mode. Runs without a window, rendering, or\n");
+    printf("                   audio, using a simulated clock. Useful with '-B'.\n");
     printf("        -i  COUNT  Sets initial number of asteroids. 'COUNT' is an\n");
     printf("                   integer between 0 and 16. The default count is 3.\n");
     printf("        -ml MASS   Sets large asteroid mass modifier. 'MASS' is a number\n");
@@ -82,15 +94,38 @@ void print_usage(void)
     printf("                   The default player count is 1.\n");
     printf("        -n  COUNT  Sets maximum asteroid count. 'COUNT' is an integer\n");
     printf("                   between 0 and 256. The default max count is 8.\n");
+    printf("        -N  COUNT  Sets how many sounds can play at once. 'COUNT' is an\n");
+    printf("                   integer from 1 to %d. The default is %d. Above %d,\n", AUDIO_VOICE_MAX, AUDIO_MIX_CHANNELS, AUDIO_MIX_CHANNELS);
+    printf("                   each sound is quieter to leave room for the rest.\n");
+    printf("        -o  FRAMES Offscreen benchmark. Draws 'FRAMES' frames into a hidden\n");
+    printf("                   window without vsync or audio, prints frame times,\n");
+    printf("                   and exits. Uses the SDL offscreen video driver when\n");
+    printf("                   available, so no display is needed.\n");
+    printf("        -O  FILE   Writes the last frame drawn to 'FILE' as a PPM image on\n");
+    printf("                   exit. Only with '-g soft'. Use with '-o' for a\n");
+    printf("                   repeatable frame.\n");
     printf("        -p         Enables asteroid collision physics. This is the default.\n");
+    printf("        -R  RATE   Sets audio sample rate. 'RATE' is an integer between\n");
+    printf("                   %d and %d. The default is %d.\n", AUDIO_RATE_MIN, AUDIO_RATE_MAX, AUDIO_SAMPLE_RATE);
     printf("        -rf RES    Fullscreen resolution. 'RES' is in the form of WxH.\n");
     printf("        -rw RES    Windowed resolution. 'RES' is in the form of WxH. The\n");
     printf("                   default is 800x600.\n");
     printf("        -s  VSYNC  Sets frame swap interval. 'VSYNC' can be on, off,\n");
     printf("                   or lateswap. The default is on.\n");
+    printf("        -S  SCALE  Draws the scene at 'SCALE' times the window size and\n");
+    printf("                   stretches it to fit. 'SCALE' is a number between\n");
+    printf("                   0.25 and 1, or 'auto' to follow the frame time.\n");
+    printf("                   The default is 1. Not used with '-g legacy'.\n");
+    printf("        -T  STATE  Enables or disables drawing on a separate render thread.\n");
+    printf("                   'STATE' can be on or off. The default is off.\n");
     printf("        -v         Print version info and exit.\n");
     printf("        -V  VOL    Sets audio volume. 'VOL' is an integer between 0 and\n");
     printf("                   127. The default is 96.\n");
+    printf("        -W  FILE   Audio benchmark. Mixes %d seconds of sound offline with\n", AUDIO_BENCH_SECONDS);
+    printf("                   1 to all channels busy (see '-N'), prints buffer times\n");
+    printf("                   against the real-time budget, writes the fullest mix\n");
+    printf("                   to 'FILE' as a WAV, and exits. No audio device is\n");
+    printf("                   used. Fails if a buffer misses its budget.\n");
     printf("        -w  SEC    Sets asteroid spawn timer in seconds. Can be an integer\n");
     printf("                   between 0 and 30, or 'off' to disable. The default is 5.\n\n");
     printf("'Simple Asteroids' uses a configuration file called 'asteroids.conf' that\n");
@@ -125,6 +160,7 @@ bool get_config_options(options *config)
     char      *config_token2; /*token of a token*/
     char      *nl;            /*points to newline char in config_line*/
     FILE      *config_file;
+    st_playerkeys *keys;
 
     #ifdef _WIN32
 
@@ -261,52 +297,70 @@ bool get_config_options(options *config)
         fprintf(config_file, "# full-res   - Fullscreen resolution. Read in the form of 'WxH'\n");
         fprintf(config_file, "# win-res    - Windowed resolution. Read in the form of 'WxH'. The default is 800x600.\n");
         fprintf(config_file, "# vsync      - VSync option. Can be 'on', 'off', or 'lateswap'. The default is 'on'.\n");
+        fprintf(config_file, "# renderer   - OpenGL renderer. Can be 'vbo' (OpenGL 1.5), 'legacy' (OpenGL 1.1), 'core' (OpenGL 3.3), or 'soft' (CPU only, no window). The default is 'vbo'.\n");
+        fprintf(config_file, "# render-thread - Draw on a separate thread, so physics and rendering overlap. Can be 'on' or 'off'. The default is 'off'.\n");
+        fprintf(config_file, "# render-scale  - Draw the scene smaller and stretch it to the window, for slow software GL. Can be between 0.25 and 1, or 'auto' to follow the frame time. The default is 1.\n");
         fprintf(config_file, "fullscreen = off\n");
         fprintf(config_file, "#full-res = 800x600\n");
         fprintf(config_file, "win-res = 800x600\n");
-        fprintf(config_file, "vsync = on\n\n");
+        fprintf(config_file, "vsync = on\n");
+        fprintf(config_file, "renderer = vbo\n");
+        fprintf(config_file, "render-thread = off\n");
+        fprintf(config_file, "render-scale = 1\n\n");
         fprintf(config_file, "### Audio options\n");
         fprintf(config_file, "# audio - Enables audio. Can be 'on' or 'off'. The default is 'on'.\n");
         fprintf(config_file, "# volume - Audio volume. Can be between 0 and 127. The default is 96.\n");
+        fprintf(config_file, "# sample-rate - Audio sample rate in Hz. Can be between %d and %d. The default is %d.\n", AUDIO_RATE_MIN, AUDIO_RATE_MAX, AUDIO_SAMPLE_RATE);
+        fprintf(config_file, "# voices - Sounds that can play at once. Can be from 1 to %d. The default is %d. Above %d, each sound is quieter so the mix doesn't clip.\n", AUDIO_VOICE_MAX, AUDIO_MIX_CHANNELS, AUDIO_MIX_CHANNELS);
         fprintf(config_file, "audio = on\n");
-        fprintf(config_file, "volume = 96\n\n");
+        fprintf(config_file, "volume = 96\n");
+        fprintf(config_file, "sample-rate = %d\n", AUDIO_SAMPLE_RATE);
+        fprintf(config_file, "voices = %d\n\n", AUDIO_MIX_CHANNELS);
         fprintf(config_file, "### Multiplayer\n");
         fprintf(config_file, "# players       - Number of players. Can be from 1 to %d\n", PLAYER_MAX);
         fprintf(config_file, "# friendly-fire - Enables players to damage each other\n");
+        fprintf(config_file, "# bots          - Players controlled by the computer, separated by spaces. Each must be within 'players'.\n");
         fprintf(config_file, "players = 1\n");
-        fprintf(config_file, "friendly-fire = on\n\n");
+        fprintf(config_file, "friendly-fire = on\n");
+        fprintf(config_file, "#bots = 2\n\n");
         fprintf(config_file, "### Key bindings\n");
         fprintf(config_file, "# Key values are expected to be enclosed in quotemarks. A full list of\n");
         fprintf(config_file, "# supported key names can be found here: http://wiki.libsdl.org/SDL_Scancode\n");
-        fprintf(config_file, "# key-p1-forward  - Moves player 1 forward. The default is \"W\".\n");
-        fprintf(config_file, "# key-p1-backward - Moves player 1 backward. The default is \"S\".\n");
-        fprintf(config_file, "# key-p1-left     - Turns player 1 left. The default is \"A\".\n");
-        fprintf(config_file, "# key-p1-right    - Turns player 1 right. The default is \"D\".\n");
-        fprintf(config_file, "# key-p1-shoot    - Player 1 shoot key. The default is \"Tab\".\n");
+        fprintf(config_file, "# key-pN-forward  - Moves player N forward.\n");
+        fprintf(config_file, "# key-pN-backward - Moves player N backward.\n");
+        fprintf(config_file, "# key-pN-left     - Turns player N left.\n");
+        fprintf(config_file, "# key-pN-right    - Turns player N right.\n");
+        fprintf(config_file, "# key-pN-shoot    - Player N shoot key.\n");
         fprintf(config_file, "# key-p1-altshoot - Shoot key for when the number of players is set to 1. The default is \"Space\".\n");
-        fprintf(config_file, "# key-p2-forward  - Moves player 2 forward. The default is \"Up\".\n");
-        fprintf(config_file, "# key-p2-backward - Moves player 2 backward. The default is \"Down\".\n");
-        fprintf(config_file, "# key-p2-left     - Turns player 2 left. The default is \"Left\".\n");
-        fprintf(config_file, "# key-p2-right    - Turns player 2 right. The default is \"Right\".\n");
-        fprintf(config_file, "# key-p2-shoot    - Player 2 shoot key. The default is \"Right Ctrl\".\n");
         fprintf(config_file, "# key-pause       - Pauses the game. The default is \"P\".\n");
         fprintf(config_file, "# key-debug       - Toggles misc info (fps, etc.). The default is \"`\".\n");
+        fprintf(config_file, "# key-capture     - Starts or stops recording video to 'asteroids-TIME.y4m'. The default is \"F12\".\n");
         fprintf(config_file, "# key-volume-up   - Increases game volume. The default is \"]\".\n");
         fprintf(config_file, "# key-volume-down - Decreases game volume. The default is \"[\".\n");
         fprintf(config_file, "# key-quit        - Closes application. The default is \"Escape\".\n");
-        fprintf(config_file, "key-p1-forward = \"W\"\n");
-        fprintf(config_file, "key-p1-backward = \"S\"\n");
-        fprintf(config_file, "key-p1-left = \"A\"\n");
-        fprintf(config_file, "key-p1-right = \"D\"\n");
-        fprintf(config_file, "key-p1-shoot = \"Tab\"\n");
-        fprintf(config_file, "key-p1-altshoot = \"Space\"\n");
-        fprintf(config_file, "key-p2-forward = \"Up\"\n");
-        fprintf(config_file, "key-p2-backward = \"Down\"\n");
-        fprintf(config_file, "key-p2-left = \"Left\"\n");
-        fprintf(config_file, "key-p2-right = \"Right\"\n");
-        fprintf(config_file, "key-p2-shoot = \"Right Ctrl\"\n");
+        fprintf(config_file, "# Players 1 to 4 have default keys. Players 5 to %d are unbound, so\n", PLAYER_MAX);
+        fprintf(config_file, "# they are best used as bots unless keys are set here.\n");
+        for(i = 0; i < PLAYER_MAX; i++)
+        {
+            keys = &config->keybind.player[i];
+            if(!keys->forward)  /*unbound*/
+                continue;
+            fprintf(config_file, "key-p%d-forward = \"%s\"\n", i+1,
+                    SDL_GetScancodeName(keys->forward));
+            fprintf(config_file, "key-p%d-backward = \"%s\"\n", i+1,
+                    SDL_GetScancodeName(keys->backward));
+            fprintf(config_file, "key-p%d-left = \"%s\"\n", i+1,
+                    SDL_GetScancodeName(keys->left));
+            fprintf(config_file, "key-p%d-right = \"%s\"\n", i+1,
+                    SDL_GetScancodeName(keys->right));
+            fprintf(config_file, "key-p%d-shoot = \"%s\"\n", i+1,
+                    SDL_GetScancodeName(keys->shoot));
+            if(i == 0)
+                fprintf(config_file, "key-p1-altshoot = \"Space\"\n");
+        }
         fprintf(config_file, "key-pause = \"P\"\n");
         fprintf(config_file, "key-debug = \"`\"\n");
+        fprintf(config_file, "key-capture = \"F12\"\n");
         fprintf(config_file, "key-volume-up = \"]\"\n");
         fprintf(config_file, "key-volume-down = \"[\"\n");
         fprintf(config_file, "key-quit = \"Escape\"\n\n");
@@ -314,6 +368,7 @@ bool get_config_options(options *config)
         fprintf(config_file, "# physics     - Enables asteroid collision physics. Can be 'on' or 'off'. The default is 'on'.\n");
         fprintf(config_file, "# init-count  - Number of asteroids that spawn initially. Can be between 0 and 16. The default is 3.\n");
         fprintf(config_file, "# max-count   - Maximum number of asteroids that can spawn. Can be between 0 and 256. The default is 8.\n");
+        fprintf(config_file, "# fragments   - Number of pieces a hit asteroid splits into. Can be between 1 and 8. The default is 2.\n");
         fprintf(config_file, "# spawn-timer - Number of seconds until a new asteroid can spawn. Can be between 0 and 30, or 'off' to disable. The default is 5.\n");
         fprintf(config_file, "# aster-scale - Asteroid scale modifier. Can be between 0.5 and 2. The default is 1.\n");
         fprintf(config_file, "# aster-massL - Large asteroid mass modifier. Can be between 0.1 and 5. The default is 1.\n");
@@ -322,6 +377,7 @@ bool get_config_options(options *config)
         fprintf(config_file, "physics = on\n");
         fprintf(config_file, "init-count = 3\n");
         fprintf(config_file, "max-count = 8\n");
+        fprintf(config_file, "fragments = 2\n");
         fprintf(config_file, "spawn-timer = 5\n");
         fprintf(config_file, "aster-scale = 1\n");
         fprintf(config_file, "aster-massL = 1\n");
@@ -358,6 +414,51 @@ bool get_config_options(options *config)
                     config->vsync = -1;
             }
         }
+        else if(!strcmp(config_token, "renderer"))      /*renderer*/
+        {
+            /*get second token*/
+            config_token = strtok(NULL, " =");
+            if(config_token)
+            {
+                if(!strcmp(config_token, "vbo"))
+                    config->renderer = RENDERER_VBO;
+                else if(!strcmp(config_token, "legacy"))
+                    config->renderer = RENDERER_LEGACY;
+                else if(!strcmp(config_token, "core"))
+                    config->renderer = RENDERER_CORE;
+                else if(!strcmp(config_token, "soft"))
+                    config->renderer = RENDERER_SOFT;
+                else
+                    fprintf(stderr, "Warning: In config file, 'renderer' must be 'vbo', 'legacy', 'core', or 'soft'.\n");
+            }
+        }
+        else if(!strcmp(config_token, "render-thread")) /*render_thread*/
+        {
+            /*get second token*/
+            config_token = strtok(NULL, " =");
+            if(config_token)
+            {
+                if(!strcmp(config_token, "on"))
+                    config->render_thread = true;
+                if(!strcmp(config_token, "off"))
+                    config->render_thread = false;
+            }
+        }
+        else if(!strcmp(config_token, "render-scale"))  /*render_scale*/
+        {
+            /*get second token*/
+            config_token = strtok(NULL, " =");
+            if(config_token)
+            {
+                f = (float) atof(config_token);
+                if(!strcmp(config_token, "auto"))
+                    config->render_scale = 0.f;
+                else if(f > 0.2499f && f < 1.0001f)
+                    config->render_scale = f;
+                else
+                    fprintf(stderr, "Warning: In config file, 'render-scale' must be a number between 0.25 and 1, or 'auto'.\n");
+            }
+        }
         else if(!strcmp(config_token, "physics"))       /*physics_enabled*/
         {
             /*get second token*/
@@ -396,6 +497,19 @@ bool get_config_options(options *config)
                     fprintf(stderr, "Warning: In config file, 'max-count' must be an integer between 0 and 256.\n");
             }
         }
+        else if(!strcmp(config_token, "fragments"))     /*aster_fragments*/
+        {
+            /*get second token*/
+            config_token = strtok(NULL, " =");
+            if(config_token)
+            {
+                i = atoi(config_token);
+                if(i > 0 && i <= 8)
+                    config->aster_fragments = i;
+                else
+                    fprintf(stderr, "Warning: In config file, 'fragments' must be an integer between 1 and 8.\n");
+            }
+        }
         else if(!strcmp(config_token, "aster-scale"))   /*aster_scale*/
         {
             /*get second token*/
@@ -545,6 +659,20 @@ bool get_config_options(options *config)
                     config->friendly_fire = false;
             }
         }
+        else if(!strcmp(config_token, "bots"))          /*bot*/
+        {
+            /*get every remaining token*/
+            while((config_token = strtok(NULL, " =,")) != NULL)
+            {
+                i = atoi(config_token);
+                if(i > 0 && i <= PLAYER_MAX)
+                    config->bot[i-1] = true;
+                else
+                    fprintf(stderr,
+            "Warning: In config file, 'bots' must be numbers from 1 to %d.\n",
+                            PLAYER_MAX);
+            }
+        }
         else if(!strcmp(config_token, "spawn-timer"))   /*spawn_timer*/
         {
             /*get second token*/
@@ -588,11 +716,39 @@ bool get_config_options(options *config)
                     fprintf(stderr, "Warning: In config file, 'volume' must be an integer between 0 and 127.\n");
             }
         }
+        else if(!strcmp(config_token, "sample-rate"))   /*audio_rate*/
+        {
+            /*get second token*/
+            config_token = strtok(NULL, " =");
+            if(config_token)
+            {
+                i = atoi(config_token);
+                if(i >= AUDIO_RATE_MIN && i <= AUDIO_RATE_MAX)
+                    config->audio_rate = i;
+                else
+                    fprintf(stderr, "Warning: In config file, 'sample-rate' must be an integer between %d and %d.\n", AUDIO_RATE_MIN, AUDIO_RATE_MAX);
+            }
+        }
+        else if(!strcmp(config_token, "voices"))        /*audio_voices*/
+        {
+            /*get second token*/
+            config_token = strtok(NULL, " =");
+            if(config_token)
+            {
+                i = atoi(config_token);
+                if(i >= 1 && i <= AUDIO_VOICE_MAX)
+                    config->audio_voices = i;
+                else
+                    fprintf(stderr, "Warning: In config file, 'voices' must be an integer between 1 and %d.\n", AUDIO_VOICE_MAX);
+            }
+        }
         else if(config_token[0] == 'k' && config_token[1] == 'e' &&
                 config_token[2] == 'y' && config_token[3] == '-')  /*key bind*/
         {
             char tmp_str[32] = {'\0'};
+            char *key_name;
             bool found_quot = false;
+            int  k;
             unsigned j;
             /*get second token*/
             config_token2 = strtok(NULL, "");
@@ -620,71 +776,30 @@ bool get_config_options(options *config)
                 fprintf(stderr, "Warning: In config file, value for '%s' is missing or not enclosed in quotemarks.\n", config_token);
             else
             {
-                if(!strcmp(config_token, "key-p1-forward"))
+                k = 0;
+                if(!strncmp(config_token, "key-p", 5))
+                    k = atoi(config_token + 5);
+                if(k > 0 && k <= PLAYER_MAX) /*key-pN-...*/
                 {
+                    keys = &config->keybind.player[k-1];
+                    key_name = strchr(config_token + 5, '-');
                     j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p1_forward = j;
-                }
-                else if(!strcmp(config_token, "key-p1-backward"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p1_backward = j;
-                }
-                else if(!strcmp(config_token, "key-p1-left"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p1_left = j;
-                }
-                else if(!strcmp(config_token, "key-p1-right"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p1_right = j;
-                }
-                else if(!strcmp(config_token, "key-p1-shoot"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p1_shoot = j;
-                }
-                else if(!strcmp(config_token, "key-p1-altshoot"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p1_altshoot = j;
-                }
-                else if(!strcmp(config_token, "key-p2-forward"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p2_forward = j;
-                }
-                else if(!strcmp(config_token, "key-p2-backward"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p2_backward = j;
-                }
-                else if(!strcmp(config_token, "key-p2-left"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p2_left = j;
-                }
-                else if(!strcmp(config_token, "key-p2-right"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p2_right = j;
-                }
-                else if(!strcmp(config_token, "key-p2-shoot"))
-                {
-                    j = SDL_GetScancodeFromName(tmp_str);
-                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
-                    else config->keybind.p2_shoot = j;
+                    if(j == SDL_SCANCODE_UNKNOWN || key_name == NULL)
+                        found_quot = true;
+                    else if(!strcmp(key_name, "-forward"))
+                        keys->forward  = j;
+                    else if(!strcmp(key_name, "-backward"))
+                        keys->backward = j;
+                    else if(!strcmp(key_name, "-left"))
+                        keys->left     = j;
+                    else if(!strcmp(key_name, "-right"))
+                        keys->right    = j;
+                    else if(!strcmp(key_name, "-shoot"))
+                        keys->shoot    = j;
+                    else if(k == 1 && !strcmp(key_name, "-altshoot"))
+                        config->keybind.p1_altshoot = j;
+                    else
+                        found_quot = true;
                 }
                 else if(!strcmp(config_token, "key-pause"))
                 {
@@ -698,6 +813,12 @@ bool get_config_options(options *config)
                     if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
                     else config->keybind.debug = j;
                 }
+                else if(!strcmp(config_token, "key-capture"))
+                {
+                    j = SDL_GetScancodeFromName(tmp_str);
+                    if(j == SDL_SCANCODE_UNKNOWN) found_quot = true;
+                    else config->keybind.capture = j;
+                }
                 else if(!strcmp(config_token, "key-volume-up"))
                 {
                     j = SDL_GetScancodeFromName(tmp_str);
@@ -766,6 +887,76 @@ bool parse_cmd_args(const int   argc,
                        return false;
                    }
                    break;
+        /*-C record video*/
+        case 'C' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -C requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   config->capture_file = argv[i+1];
+                   break;
+        /*-T enable/disable render thread*/
+        case 'T' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -T requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   if(!strcmp(argv[i+1], "on"))
+                       config->render_thread = true;
+                   else if(!strcmp(argv[i+1], "off"))
+                       config->render_thread = false;
+                   else
+                   {
+                       fprintf(stderr,"Invalid render thread parameter '%s'\n",
+                               argv[i+1]);
+                       print_usage();
+                       return false;
+                   }
+                   break;
+        /*-S render scale*/
+        case 'S' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -S requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   a_scale = (float) atof(argv[i+1]);
+                   if(!strcmp(argv[i+1], "auto"))
+                       config->render_scale = 0.f;
+                   else if(a_scale > 0.2499f && a_scale < 1.0001f)
+                       config->render_scale = a_scale;
+                   else
+                   {
+                       fprintf(stderr,
+                   "Render scale must be a number between 0.25 and 1, or auto\n");
+                       print_usage();
+                       return false;
+                   }
+                   break;
+        /*-g renderer*/
+        case 'g' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -g requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   if(!strcmp(argv[i+1], "vbo"))
+                       config->renderer = RENDERER_VBO;
+                   else if(!strcmp(argv[i+1], "legacy"))
+                       config->renderer = RENDERER_LEGACY;
+                   else if(!strcmp(argv[i+1], "core"))
+                       config->renderer = RENDERER_CORE;
+                   else if(!strcmp(argv[i+1], "soft"))
+                       config->renderer = RENDERER_SOFT;
+                   else
+                   {
+                       fprintf(stderr, "Invalid renderer '%s'\n", argv[i+1]);
+                       print_usage();
+                       return false;
+                   }
+                   break;
         /*-n max asteroid count*/
         case 'n' : if(i+2 > argc)
                    {
@@ -808,6 +999,24 @@ bool parse_cmd_args(const int   argc,
                        return false;
                    }
                    break;
+        /*-c asteroid fragment count*/
+        case 'c' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -c requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   a_count = atoi(argv[i+1]);
+                   if(a_count > 0 && a_count <= 8)
+                       config->aster_fragments = a_count;
+                   else
+                   {
+                       fprintf(stderr,
+                  "Number of fragments must be an integer between 1 and 8\n");
+                       print_usage();
+                       return false;
+                   }
+                   break;
         /*-b asteroid scale modifier*/
         case 'b' : if(i+2 > argc)
                    {
@@ -911,6 +1120,63 @@ bool parse_cmd_args(const int   argc,
                        return false;
                    }
                    break;
+        /*-B computer controlled player*/
+        case 'B' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -B requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   a_count = atoi(argv[i+1]);
+                   if(a_count > 0 && a_count <= PLAYER_MAX)
+                       config->bot[a_count-1] = true;
+                   else
+                   {
+                       fprintf(stderr, "Bot player must be 1 to %d\n",
+                               PLAYER_MAX);
+                       print_usage();
+                       return false;
+                   }
+                   break;
+        /*-H headless mode*/
+        case 'H' : config->headless = true;
+                   break;
+        /*-O write last frame*/
+        case 'O' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -O requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   config->image_file = argv[i+1];
+                   break;
+        /*-W audio benchmark*/
+        case 'W' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -W requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   config->audio_file = argv[i+1];
+                   break;
+        /*-o offscreen benchmark*/
+        case 'o' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -o requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   a_count = atoi(argv[i+1]);
+                   if(a_count > 0)
+                       config->bench_frames = (unsigned)a_count;
+                   else
+                   {
+                       fprintf(stderr,
+                               "Benchmark frame count must be at least 1\n");
+                       print_usage();
+                       return false;
+                   }
+                   break;
         /*-f enable/disable friendly fire*/
         case 'f' : if(i+2 > argc)
                    {
@@ -1066,11 +1332,61 @@ bool parse_cmd_args(const int   argc,
                        return false;
                    }
                    break;
+        /*-R audio sample rate*/
+        case 'R' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -R requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   a_count = atoi(argv[i+1]);
+                   if(a_count >= AUDIO_RATE_MIN && a_count <= AUDIO_RATE_MAX)
+                       config->audio_rate = a_count;
+                   else
+                   {
+                       fprintf(stderr,
+                              "Sample rate must be an integer between %d and %d\n",
+                              AUDIO_RATE_MIN, AUDIO_RATE_MAX);
+                       print_usage();
+                       return false;
+                   }
+                   break;
+        /*-N audio channel count*/
+        case 'N' : if(i+2 > argc)
+                   {
+                       fprintf(stderr, "Option -N requires a specifier\n");
+                       print_usage();
+                       return false;
+                   }
+                   a_count = atoi(argv[i+1]);
+                   if(a_count >= 1 && a_count <= AUDIO_VOICE_MAX)
+                       config->audio_voices = a_count;
+                   else
+                   {
+                       fprintf(stderr,
+                              "Sound count must be an integer between 1 and %d\n",
+                              AUDIO_VOICE_MAX);
+                       print_usage();
+                       return false;
+                   }
+                   break;
         default  : fprintf(stderr, "Invalid option '%s'\n", argv[i]);
                    print_usage();
                    return false;
         }
     }
+    if(config->headless && config->bench_frames)
+    {
+        fprintf(stderr, "Options -H and -o cannot be used together\n");
+        print_usage();
+        return false;
+    }
+    if(config->image_file && config->renderer != RENDERER_SOFT)
+    {
+        fprintf(stderr, "Option -O requires '-g soft'\n");
+        print_usage();
+        return false;
+    }
     return true;
 }
 
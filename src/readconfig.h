@@ -40,20 +40,24 @@ typedef struct resolution {
     int         refresh;
 } resolution;
 
+/*** per-player key bindings ***
+ *
+ * A scancode of 0 (SDL_SCANCODE_UNKNOWN) means the key is unbound.
+ **/
+typedef struct st_playerkeys {
+    unsigned forward;
+    unsigned backward;
+    unsigned left;
+    unsigned right;
+    unsigned shoot;
+} st_playerkeys;
+
 typedef struct st_keybind {
-    unsigned p1_forward;
-    unsigned p1_backward;
-    unsigned p1_left;
-    unsigned p1_right;
-    unsigned p1_shoot;
+    st_playerkeys player[PLAYER_MAX];
     unsigned p1_altshoot;
-    unsigned p2_forward;
-    unsigned p2_backward;
-    unsigned p2_left;
-    unsigned p2_right;
-    unsigned p2_shoot;
     unsigned pause;
     unsigned debug;
+    unsigned capture;
     unsigned vol_up;
     unsigned vol_down;
     unsigned quit;
@@ -65,10 +69,16 @@ typedef struct options {
     bool        audio_enabled;
     bool        friendly_fire;
     int         audio_volume;
+    int         audio_rate;  /*output sample rate in Hz*/
+    int         audio_voices; /*sounds that can play at once*/
     int         player_count;
     int         vsync;
+    int         renderer; /*see RENDERER_* defines*/
+    bool        render_thread;
+    float       render_scale; /*fraction of the window drawn, 0 = auto*/
     int         aster_max_count;
     int         aster_init_count;
+    int         aster_fragments; /*pieces a hit asteroid splits into*/
     unsigned    spawn_timer;
     float       aster_scale;
     float       aster_mass_large;
@@ -78,6 +88,12 @@ typedef struct options {
     resolution  winres;
     resolution  fullres;
     st_keybind  keybind;
+    bool        headless;
+    unsigned    bench_frames; /*offscreen benchmark length, 0 = off*/
+    const char *capture_file; /*record from the start, NULL = off*/
+    const char *image_file;   /*PPM of the last soft frame, NULL = off*/
+    const char *audio_file;   /*WAV of the audio benchmark, NULL = off*/
+    bool        bot[PLAYER_MAX]; /*player slots controlled by update_bots()*/
 } options;
 
 /* Get configuration settings.
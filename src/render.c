@@ -38,20 +38,105 @@
   #include <GL/gl.h>
 #endif
 #include <SDL.h>
-#include "objects.h"
+#include <math.h>
+#include <stdio.h>
+#include "glfunc.h"
+#include "glstats.h"
 #include "global.h"
 #include "shared.h"
+#include "text.h"
+#include "glcore.h"
+#include "stream.h"
+#include "softrender.h"
+#include "scale.h"
+#include "particles.h"
+#include "mesh.h"
 
-void draw_objects(st_shared *draw)
+/* Transform every spawned asteroid into one batch of lines.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * Each asteroid outline is rotated, scaled, and translated on the
+ * CPU (same order as get_real_point_pos()), then written to
+ * draw->aster_batch as separate GL_LINES segments, so the whole
+ * field can be drawn with a single call whatever the variants.
+ *
+ * Returns the number of vertices written.
+ **/
+int batch_asteroids(st_shared *draw)
+{
+    int                   i,j;
+    int                   count   = 0;
+    const float           rad_mod = M_PI/180.f;
+    const unsigned short *index;
+    float                 c,s;
+    float                 point[ASTER_EDGES][2]; /*transformed outline*/
+    float                *out     = draw->aster_batch;
+    asteroid             *a;
+
+    for(i = 0; i < (*draw->config).aster_max_count; i++)
+    {
+        a = &(*draw->aster)[i];
+        if(!a->is_spawned)
+            continue;
+        c = cos(a->rot*rad_mod) * a->scale;
+        s = sin(a->rot*rad_mod) * a->scale;
+        index = &mesh_atlas.index[
+                    mesh_atlas.mesh[MESH_ASTER + a->variant].first];
+        for(j = 0; j < ASTER_EDGES; j++)
+        {
+            const float *v = &mesh_atlas.verts[index[j]*2];
+            point[j][0] =  v[0]*c + v[1]*s + a->pos[0];
+            point[j][1] = -v[0]*s + v[1]*c + a->pos[1];
+        }
+        /*line loop -> line segments*/
+        for(j = 0; j < ASTER_EDGES; j++)
+        {
+            *out++ = point[j][0];
+            *out++ = point[j][1];
+            *out++ = point[(j+1) % ASTER_EDGES][0];
+            *out++ = point[(j+1) % ASTER_EDGES][1];
+            count += 2;
+        }
+    }
+    return count;
+}
+
+/* Draw a mesh from the atlas with the fixed function pipeline.
+ *
+ *     draw - struct containing variables required for drawing
+ *     id   - mesh ID, see MESH_* defines
+ *
+ * Calls the mesh's display list if there is one, otherwise draws
+ * its indices from client memory (legacy) or the index buffer.
+ **/
+void draw_mesh(st_shared *draw, const int id)
 {
-    int i;
-    char pause_msg[]     = "PAUSED";
-    char p1_score[32]    = {'\0'};
-    char p1_topscore[32] = {'\0'};
-    char p2_score[32]    = {'\0'};
-    char p2_topscore[32] = {'\0'};
+    const st_mesh *m = &mesh_atlas.mesh[id];
 
-    glViewport(0, 0, *draw->width_real, *draw->height_real);
+    if(draw->gl_lists)
+        glCallList(draw->gl_lists + id);
+    else if(draw->legacy_context)
+        glDrawElements(m->mode, m->count, GL_UNSIGNED_SHORT,
+                &mesh_atlas.index[m->first]);
+    else
+        glDrawElements(m->mode, m->count, GL_UNSIGNED_SHORT,
+                (void*)(intptr_t)(sizeof(unsigned short)*m->first));
+}
+
+/* Draw particles, asteroids, players, projectiles, and blasts.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * Fixed function path for OpenGL 1.5 and 1.1 contexts. The 1.1 path
+ * calls the display lists from init_lists() when they exist.
+ **/
+void draw_world(st_shared *draw)
+{
+    int      i,j;
+    unsigned offset;
+
+    glViewport(0, 0, draw->scale.width, draw->scale.height);
     glClear(GL_COLOR_BUFFER_BIT);
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
@@ -59,28 +144,53 @@ void draw_objects(st_shared *draw)
             *draw->bottom_clip, *draw->top_clip, -1.f, 1.f);
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
+    /*particles, all in one draw call*/
+    j = batch_particles(draw->particles, draw->particle_batch);
+    if(j && draw->legacy_context)
+    {
+        glVertexPointer(2, GL_FLOAT, 0, draw->particle_batch);
+        glDrawArrays(GL_POINTS, 0, j);
+        glVertexPointer(2, GL_FLOAT, 0, mesh_atlas.verts);
+    }
+    else if(j)
+    {
+        offset = stream_write(&draw->stream, draw->particle_batch,
+                sizeof(float)*2*j);
+        glVertexPointer(2, GL_FLOAT, 0, (void*)(intptr_t)(offset));
+        glDrawArrays(GL_POINTS, 0, j);
+        glBindBufferARB_ptr(GL_ARRAY_BUFFER, draw->gl_buffers[0]);
+        glVertexPointer(2, GL_FLOAT, 0, (void*)(intptr_t)(0));
+    }
     /*asteroids*/
-    for(i = 0; i < (*draw->config).aster_max_count; i++)
+    if(!draw->legacy_context) /*one draw call for the whole field*/
     {
-        if((*draw->aster)[i].is_spawned)
+        j = batch_asteroids(draw);
+        if(j)
         {
-            glPushMatrix();
-            glTranslatef((*draw->aster)[i].pos[0],
-                         (*draw->aster)[i].pos[1], 0.f);
-            glScalef((*draw->aster)[i].scale,(*draw->aster)[i].scale,1.f);
-            glRotatef((*draw->aster)[i].rot, 0.f, 0.f, -1.f);
-            /*draw asteroid 'i'*/
-            if(draw->legacy_context)
-                glDrawElements(GL_LINE_LOOP,
-                        object_element_count[5],
-                        GL_UNSIGNED_BYTE,
-                        &object_index[object_index_offsets[2]]);
-            else
-                glDrawElements(GL_LINE_LOOP,
-                        object_element_count[5],
-                        GL_UNSIGNED_BYTE,
-                        (void*)(intptr_t)object_index_offsets[2]);
-            glPopMatrix();
+            offset = stream_write(&draw->stream, draw->aster_batch,
+                    sizeof(float)*2*j);
+            glVertexPointer(2, GL_FLOAT, 0, (void*)(intptr_t)(offset));
+            glDrawArrays(GL_LINES, 0, j);
+            /*back to the static object buffer*/
+            glBindBufferARB_ptr(GL_ARRAY_BUFFER, draw->gl_buffers[0]);
+            glVertexPointer(2, GL_FLOAT, 0, (void*)(intptr_t)(0));
+        }
+    }
+    else
+    {
+        for(i = 0; i < (*draw->config).aster_max_count; i++)
+        {
+            if((*draw->aster)[i].is_spawned)
+            {
+                glPushMatrix();
+                glTranslatef((*draw->aster)[i].pos[0],
+                             (*draw->aster)[i].pos[1], 0.f);
+                glScalef((*draw->aster)[i].scale,(*draw->aster)[i].scale,1.f);
+                glRotatef((*draw->aster)[i].rot, 0.f, 0.f, -1.f);
+                /*draw asteroid 'i'*/
+                draw_mesh(draw, MESH_ASTER + (*draw->aster)[i].variant);
+                glPopMatrix();
+            }
         }
     }
     /*players*/
@@ -91,31 +201,13 @@ void draw_objects(st_shared *draw)
         if(!(*draw->plyr)[i].died) /*still alive*/
         {
             glRotatef((*draw->plyr)[i].rot, 0.f, 0.f, -1.f);
-            if(draw->legacy_context)
-                glDrawElements(GL_LINE_LOOP,
-                        object_element_count[1],
-                        GL_UNSIGNED_BYTE,
-                        &object_index[object_index_offsets[0]]);
-            else
-                glDrawElements(GL_LINE_LOOP,
-                        object_element_count[1],
-                        GL_UNSIGNED_BYTE,
-                        (void*)(intptr_t)object_index_offsets[0]);
+            draw_mesh(draw, MESH_PLAYER);
             /*projectile*/
             if((*draw->plyr)[i].key_shoot && !*draw->paused)
             {
                 glTranslatef((*draw->plyr)[i].shot.pos[0],
                              (*draw->plyr)[i].shot.pos[1], 0.f);
-                if(draw->legacy_context)
-                    glDrawElements(GL_LINES,
-                            object_element_count[3],
-                            GL_UNSIGNED_BYTE,
-                            &object_index[object_index_offsets[1]]);
-                else
-                    glDrawElements(GL_LINES,
-                            object_element_count[3],
-                            GL_UNSIGNED_BYTE,
-                            (void*)(intptr_t)object_index_offsets[1]);
+                draw_mesh(draw, MESH_PROJECTILE);
             }
         }
         else /*player death effect*/
@@ -123,292 +215,109 @@ void draw_objects(st_shared *draw)
             glPushMatrix();
             glScalef((*draw->plyr)[i].blast_scale,
                      (*draw->plyr)[i].blast_scale, 1.f);
-            if(draw->legacy_context)
-                glDrawElements(GL_LINES,
-                        object_element_count[7],
-                        GL_UNSIGNED_BYTE,
-                        &object_index[object_index_offsets[3]]);
-            else
-                glDrawElements(GL_LINES,
-                        object_element_count[7],
-                        GL_UNSIGNED_BYTE,
-                        (void*)(intptr_t)object_index_offsets[3]);
+            draw_mesh(draw, MESH_BLAST);
             glPopMatrix();
             /*draw second smaller effect at 90 degree rotation*/
             glScalef((*draw->plyr)[i].blast_scale*0.5f,
                      (*draw->plyr)[i].blast_scale*0.5f, 1.f);
             glRotatef(90.f, 0.f, 0.f, -1.f);
-            if(draw->legacy_context)
-                glDrawElements(GL_LINES,
-                        object_element_count[7],
-                        GL_UNSIGNED_BYTE,
-                        &object_index[object_index_offsets[3]]);
-            else
-                glDrawElements(GL_LINES,
-                        object_element_count[7],
-                        GL_UNSIGNED_BYTE,
-                        (void*)(intptr_t)object_index_offsets[3]);
+            draw_mesh(draw, MESH_BLAST);
         }
         glPopMatrix();
     }
-    /*score*/
-    sprintf(p1_score,    "SCORE     %u", (*draw->plyr)[0].score);
-    sprintf(p1_topscore, "HI SCORE  %u", (*draw->plyr)[0].top_score);
-    glPushMatrix(); /*P1 SCORE*/
-    glTranslatef(*draw->left_clip + 0.02f, *draw->top_clip - 0.02f, 0.f);
-    glScalef(0.5f, 0.5f, 0.f);
-    for(i = 0; (unsigned)i < sizeof(p1_score); i++)
-    {
-        int tmp_char = 0;
-        if(p1_score[i] != ' ')
-        {
-            if(p1_score[i] == '\0')
-                break;
-            else if(p1_score[i] > 0x2F && p1_score[i] < 0x3A)
-                tmp_char = p1_score[i] - 0x2B; /* 0-9 */
-            else if(p1_score[i] > 0x40 && p1_score[i] < 0x5B)
-                tmp_char = p1_score[i] - 0x32; /* A-Z */
-            else
-                break;
-            if(draw->legacy_context)
-                glDrawElements(GL_LINE_STRIP,
-                        object_element_count[(tmp_char*2)-1],
-                        GL_UNSIGNED_BYTE,
-                        &object_index[object_index_offsets[tmp_char-1]]);
-            else
-                glDrawElements(GL_LINE_STRIP,
-                        object_element_count[(tmp_char*2)-1],
-                        GL_UNSIGNED_BYTE,
-                        (void*)(intptr_t)object_index_offsets[tmp_char-1]);
-        }
-        glTranslatef(0.06f, 0.f, 0.f);
-    }
-    glPopMatrix();
-    glPushMatrix(); /*P1 HI SCORE*/
-    glTranslatef(*draw->left_clip + 0.02f, *draw->top_clip - 0.08f, 0.f);
-    glScalef(0.5f, 0.5f, 0.f);
-    for(i = 0; (unsigned)i < sizeof(p1_topscore); i++)
-    {
-        int tmp_char = 0;
-        if(p1_topscore[i] != ' ')
-        {
-            if(p1_topscore[i] == '\0')
-                break;
-            else if(p1_topscore[i] > 0x2F &&
-                    p1_topscore[i] < 0x3A) /* 0-9 */
-                tmp_char = p1_topscore[i] - 0x2B;
-            else if(p1_topscore[i] > 0x40 &&
-                    p1_topscore[i] < 0x5B) /* A-Z */
-                tmp_char = p1_topscore[i] - 0x32;
-            else
-                break;
-            if(draw->legacy_context)
-                glDrawElements(GL_LINE_STRIP,
-                        object_element_count[(tmp_char*2)-1],
-                        GL_UNSIGNED_BYTE,
-                        &object_index[object_index_offsets[tmp_char-1]]);
-            else
-                glDrawElements(GL_LINE_STRIP,
-                        object_element_count[(tmp_char*2)-1],
-                        GL_UNSIGNED_BYTE,
-                        (void*)(intptr_t)object_index_offsets[tmp_char-1]);
-        }
-        glTranslatef(0.06f, 0.f, 0.f);
-    }
-    glPopMatrix();
-    if((*draw->config).player_count > 1)
+}
+
+/* Draw the scores, pause message, and fps indicator.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * The audio callback timing sits above the fps indicator when
+ * audio is on, and GL_STATS builds show the GL call counts of
+ * the last frame above that.
+ **/
+void draw_hud(st_shared *draw)
+{
+    int  k;
+    int  columns;
+    char pause_msg[] = "PAUSED";
+#ifdef GL_STATS
+    char stats[64];
+#endif
+
+    /*score, laid out in up to 4 columns per row*/
+    columns = (*draw->config).player_count < 4 ?
+              (*draw->config).player_count : 4;
+    for(k = 0; k < (*draw->config).player_count; k++)
     {
-        sprintf(p2_score,    "SCORE     %u", (*draw->plyr)[1].score);
-        sprintf(p2_topscore, "HI SCORE  %u", (*draw->plyr)[1].top_score);
-        glPushMatrix(); /*P2 SCORE*/
-        glTranslatef(*draw->right_clip - 7.f*0.06f - 0.02f,
-                     *draw->top_clip - 0.02f, 0.f);
-        glScalef(0.5f, 0.5f, 0.f);
-        for(i = 0; (unsigned)i < sizeof(p2_score); i++)
-        {
-            int tmp_char = 0;
-            if(p2_score[i] != ' ')
-            {
-                if(p2_score[i] == '\0')
-                    break;
-                else if(p2_score[i] > 0x2F &&
-                        p2_score[i] < 0x3A) /* 0-9 */
-                    tmp_char = p2_score[i] - 0x2B;
-                else if(p2_score[i] > 0x40 &&
-                        p2_score[i] < 0x5B) /* A-Z */
-                    tmp_char = p2_score[i] - 0x32;
-                else
-                    break;
-                if(draw->legacy_context)
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            &object_index[object_index_offsets[tmp_char-1]]);
-                else
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            (void*)(intptr_t)object_index_offsets[tmp_char-1]);
-            }
-            glTranslatef(0.06f, 0.f, 0.f);
-        }
-        glPopMatrix();
-        glPushMatrix(); /*P2 HI SCORE*/
-        glTranslatef(*draw->right_clip - 7.f*0.06f - 0.02f,
-                     *draw->top_clip - 0.08f, 0.f);
-        glScalef(0.5f, 0.5f, 0.f);
-        for(i = 0; (unsigned)i < sizeof(p2_topscore); i++)
-        {
-            int tmp_char = 0;
-            if(p2_topscore[i] != ' ')
-            {
-                if(p2_topscore[i] == '\0')
-                    break;
-                else if(p2_topscore[i] > 0x2F &&
-                        p2_topscore[i] < 0x3A) /* 0-9 */
-                    tmp_char = p2_topscore[i] - 0x2B;
-                else if(p2_topscore[i] > 0x40 &&
-                        p2_topscore[i] < 0x5B) /* A-Z */
-                    tmp_char = p2_topscore[i] - 0x32;
-                else
-                    break;
-                if(draw->legacy_context)
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            &object_index[object_index_offsets[tmp_char-1]]);
-                else
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            (void*)(intptr_t)object_index_offsets[tmp_char-1]);
-            }
-            glTranslatef(0.06f, 0.f, 0.f);
-        }
-        glPopMatrix();
+        float x = *draw->left_clip + 0.02f;
+        float y = *draw->top_clip  - 0.02f - (float)(k / 4)*0.14f;
+        if(columns > 1)
+            x += (float)(k % 4) * (*draw->right_clip - *draw->left_clip -
+                    7.f*0.06f - 0.04f) / (float)(columns - 1);
+        set_text_uint(&draw->hud[HUD_SCORE(k)], "SCORE     ",
+                      (*draw->plyr)[k].score);
+        set_text_uint(&draw->hud[HUD_HISCORE(k)], "HI SCORE  ",
+                      (*draw->plyr)[k].top_score);
+        draw_text(draw, &draw->hud[HUD_SCORE(k)],   x, y,         0.5f);
+        draw_text(draw, &draw->hud[HUD_HISCORE(k)], x, y - 0.06f, 0.5f);
     }
     /*pause message*/
     if(*draw->paused)
     {
-        glPushMatrix();
-        glTranslatef((-0.06f*strlen(pause_msg))*0.5f, 0.04f, 0.f);
-        for(i = 0; (unsigned)i < sizeof(pause_msg); i++)
-        {
-            int tmp_char = 0;
-            if(pause_msg[i] != ' ')
-            {
-                if(pause_msg[i] == '\0')
-                    break;
-                else if(pause_msg[i] > 0x2F &&
-                        pause_msg[i] < 0x3A) /* 0-9 */
-                    tmp_char = pause_msg[i] - 0x2B;
-                else if(pause_msg[i] > 0x40 &&
-                        pause_msg[i] < 0x5B) /* A-Z */
-                    tmp_char = pause_msg[i] - 0x32;
-                else
-                    break;
-                if(draw->legacy_context)
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            &object_index[object_index_offsets[tmp_char-1]]);
-                else
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            (void*)(intptr_t)object_index_offsets[tmp_char-1]);
-            }
-            glTranslatef(0.06f, 0.f, 0.f);
-        }
-        glPopMatrix();
+        set_text(&draw->hud[HUD_PAUSE], pause_msg);
+        draw_text(draw, &draw->hud[HUD_PAUSE],
+                  (-0.06f*strlen(pause_msg))*0.5f, 0.04f, 1.f);
     }
-    /*fps indicator*/
+    /*fps and mspf indicators*/
     if(*draw->show_fps)
     {
-        glPushMatrix();
-        glTranslatef(*draw->left_clip + 0.02f, *draw->bottom_clip + 0.12f,0.f);
-        glScalef(0.5f, 0.5f, 0.f);
-        for(i = 0; (unsigned)i < strlen(draw->fps); i++)
+        set_text(&draw->hud[HUD_FPS],  draw->fps);
+        set_text(&draw->hud[HUD_MSPF], draw->mspf);
+        draw_text(draw, &draw->hud[HUD_FPS],
+                  *draw->left_clip + 0.02f, *draw->bottom_clip + 0.12f, 0.5f);
+        draw_text(draw, &draw->hud[HUD_MSPF],
+                  *draw->left_clip + 0.02f, *draw->bottom_clip + 0.06f, 0.5f);
+        if(draw->audio_time[0])
         {
-            int tmp_char = 0;
-            if((draw->fps)[i] != ' ')
-            {
-                if((draw->fps)[i] == '\0')
-                    break;
-                else if((draw->fps)[i] > 0x2F &&
-                        (draw->fps)[i] < 0x3A) /* 0-9 */
-                    tmp_char = (draw->fps)[i] - 0x2B;
-                else if((draw->fps)[i] > 0x40 &&
-                        (draw->fps)[i] < 0x5B) /* A-Z */
-                    tmp_char = (draw->fps)[i] - 0x32;
-                else if((draw->fps)[i] == 0x2E) /* . */
-                {
-                    tmp_char = 2;
-                    glPushMatrix();
-                    glTranslatef(0.f, -0.08f, 0.f);
-                }
-                else
-                    break;
-                if(draw->legacy_context)
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            &object_index[object_index_offsets[tmp_char-1]]);
-                else
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            (void*)(intptr_t)object_index_offsets[tmp_char-1]);
-                if(tmp_char == 2)
-                    glPopMatrix();
-            }
-            glTranslatef(0.06f, 0.f, 0.f);
+            set_text(&draw->hud[HUD_AUDIOTIME], draw->audio_time);
+            set_text(&draw->hud[HUD_AUDIOLATE], draw->audio_late);
+            draw_text(draw, &draw->hud[HUD_AUDIOTIME],
+                  *draw->left_clip + 0.02f, *draw->bottom_clip + 0.24f, 0.5f);
+            draw_text(draw, &draw->hud[HUD_AUDIOLATE],
+                  *draw->left_clip + 0.02f, *draw->bottom_clip + 0.18f, 0.5f);
         }
-        glPopMatrix();
+#ifdef GL_STATS
+        sprintf(stats, "DRAW %lu VERT %lu",
+                gl_stats_frame.draws, gl_stats_frame.verts);
+        set_text(&draw->hud[HUD_GLDRAW], stats);
+        sprintf(stats, "MATRIX %lu STATE %lu",
+                gl_stats_frame.matrix, gl_stats_frame.state);
+        set_text(&draw->hud[HUD_GLSTATE], stats);
+        draw_text(draw, &draw->hud[HUD_GLDRAW],
+                  *draw->left_clip + 0.02f, *draw->bottom_clip + 0.36f, 0.5f);
+        draw_text(draw, &draw->hud[HUD_GLSTATE],
+                  *draw->left_clip + 0.02f, *draw->bottom_clip + 0.30f, 0.5f);
+#endif
     }
-    /*mspf indicator*/
-    if(*draw->show_fps)
+}
+
+void draw_objects(st_shared *draw)
+{
+#ifdef GL_STATS
+    /*everything since the last call belongs to the previous frame*/
+    gl_stats_frame = gl_stats;
+    gl_stats.draws = gl_stats.verts = gl_stats.matrix = gl_stats.state = 0;
+#endif
+    if(draw->soft)
+        draw_soft_objects(draw);
+    else
     {
-        glPushMatrix();
-        glTranslatef(*draw->left_clip + 0.02f, *draw->bottom_clip + 0.06f,0.f);
-        glScalef(0.5f, 0.5f, 0.f);
-        for(i = 0; (unsigned)i < strlen(draw->mspf); i++)
-        {
-            int tmp_char = 0;
-            if((draw->mspf)[i] != ' ')
-            {
-                if((draw->mspf)[i] == '\0')
-                    break;
-                else if((draw->mspf)[i] > 0x2F &&
-                        (draw->mspf)[i] < 0x3A) /* 0-9 */
-                    tmp_char = (draw->mspf)[i] - 0x2B;
-                else if((draw->mspf)[i] > 0x40 &&
-                        (draw->mspf)[i] < 0x5B) /* A-Z */
-                    tmp_char = (draw->mspf)[i] - 0x32;
-                else if((draw->mspf)[i] == 0x2E) /* . */
-                {
-                    tmp_char = 2;
-                    glPushMatrix();
-                    glTranslatef(0.f, -0.08f, 0.f);
-                }
-                else
-                    break;
-                if(draw->legacy_context)
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            &object_index[object_index_offsets[tmp_char-1]]);
-                else
-                    glDrawElements(GL_LINE_STRIP,
-                            object_element_count[(tmp_char*2)-1],
-                            GL_UNSIGNED_BYTE,
-                            (void*)(intptr_t)object_index_offsets[tmp_char-1]);
-                if(tmp_char == 2)
-                    glPopMatrix();
-            }
-            glTranslatef(0.06f, 0.f, 0.f);
-        }
-        glPopMatrix();
+        scale_begin(draw);
+        if(draw->core_context)
+            draw_core_objects(draw);
+        else
+            draw_world(draw);
+        scale_end(draw);
     }
+    draw_hud(draw);
 }
-
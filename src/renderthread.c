@@ -0,0 +1,216 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "global.h"
+#include "shared.h"
+#include "render.h"
+#include "capture.h"
+#include "renderthread.h"
+
+/* Render thread main loop.
+ *
+ *     data - the st_shared given to start_render_thread()
+ *
+ * Draws with a private copy of st_shared whose object pointers
+ * are moved to each snapshot as it is taken. GL state in the copy
+ * (buffers, stream, HUD) is only used by this thread from now on.
+ *
+ * Returns 0 when asked to quit.
+ **/
+int render_thread_main(void *data)
+{
+    st_shared   *shared = (st_shared*) data;
+    st_render   *render = shared->render;
+    st_shared    view   = *shared;
+    st_snapshot *snap;
+    player      *plyr;
+    asteroid    *aster;
+    bool         paused;
+    bool         show_fps;
+    bool         capturing;
+
+    view.plyr      = &plyr;
+    view.aster     = &aster;
+    view.paused    = &paused;
+    view.show_fps  = &show_fps;
+    view.capturing = &capturing;
+    if(SDL_GL_MakeCurrent(*view.win_main, *view.win_main_gl))
+    {
+        fprintf(stderr, "SDL GL MakeCurrent: %s\n", SDL_GetError());
+        SDL_AtomicSet(&render->quit, 1);
+        SDL_SemPost(render->taken);
+        return 1;
+    }
+    SDL_SemPost(render->taken); /*ready*/
+    for(;;)
+    {
+        SDL_SemWait(render->fresh);
+        if(SDL_AtomicGet(&render->quit))
+            break;
+        if(!(SDL_AtomicGet(&render->middle) & SNAPSHOT_FRESH))
+            continue;
+        /*take the published slot, leave ours for the simulation*/
+        render->front = SDL_AtomicSet(&render->middle, render->front) & 0x3;
+        snap      = &render->snap[render->front];
+        plyr      = snap->plyr;
+        aster     = snap->aster;
+        paused    = snap->paused;
+        show_fps  = snap->show_fps;
+        capturing = snap->capturing;
+        view.fps  = snap->fps;
+        view.mspf = snap->mspf;
+        view.audio_time = snap->audio_time;
+        view.audio_late = snap->audio_late;
+        view.particles = &snap->particles;
+        draw_objects(&view);
+        capture_frame(&view);
+        SDL_GL_SwapWindow(*view.win_main);
+    }
+    stop_capture(&view); /*needs the context to flush*/
+    SDL_GL_MakeCurrent(*view.win_main, NULL);
+    return 0;
+}
+
+bool start_render_thread(st_shared *shared)
+{
+    int        i;
+    st_render *render;
+
+    render = (st_render*) calloc(1, sizeof(st_render));
+    if(!render)
+        return false;
+    for(i = 0; i < 3; i++)
+    {
+        render->snap[i].aster = (asteroid*) malloc(sizeof(asteroid) *
+                shared->config->aster_max_count);
+        render->snap[i].plyr  = (player*) malloc(sizeof(player) *
+                shared->config->player_count);
+        /*only what drawing reads*/
+        render->snap[i].particles.count = 0;
+        render->snap[i].particles.x     = (float*) malloc(sizeof(float) *
+                2 * PARTICLE_MAX);
+        render->snap[i].particles.y     = render->snap[i].particles.x +
+                PARTICLE_MAX;
+        render->snap[i].particles.vx    = NULL;
+        render->snap[i].particles.vy    = NULL;
+        render->snap[i].particles.life  = NULL;
+    }
+    render->back  = 0;
+    render->front = 1;
+    SDL_AtomicSet(&render->middle, 2);
+    SDL_AtomicSet(&render->quit, 0);
+    render->fresh = SDL_CreateSemaphore(0);
+    render->taken = SDL_CreateSemaphore(0);
+    shared->render = render;
+    /*the context can only be current on one thread at a time*/
+    SDL_GL_MakeCurrent(*shared->win_main, NULL);
+    if(!render->fresh || !render->taken ||
+       !(render->thread = SDL_CreateThread(render_thread_main, "render",
+                                            shared)))
+    {
+        fprintf(stderr, "SDL Create Thread: %s\n", SDL_GetError());
+        SDL_ClearError();
+        SDL_GL_MakeCurrent(*shared->win_main, *shared->win_main_gl);
+        stop_render_thread(shared);
+        return false;
+    }
+    /*wait until the thread has the context*/
+    SDL_SemWait(render->taken);
+    if(SDL_AtomicGet(&render->quit))
+    {
+        stop_render_thread(shared);
+        return false;
+    }
+    return true;
+}
+
+void publish_snapshot(st_shared *sim)
+{
+    st_render   *render = sim->render;
+    st_snapshot *snap   = &render->snap[render->back];
+    int          old;
+
+    memcpy(snap->aster, *sim->aster,
+            sizeof(asteroid) * sim->config->aster_max_count);
+    memcpy(snap->plyr, *sim->plyr,
+            sizeof(player) * sim->config->player_count);
+    snap->particles.count = sim->particles->count;
+    memcpy(snap->particles.x, sim->particles->x,
+            sizeof(float) * sim->particles->count);
+    memcpy(snap->particles.y, sim->particles->y,
+            sizeof(float) * sim->particles->count);
+    snap->paused    = *sim->paused;
+    snap->show_fps  = *sim->show_fps;
+    snap->capturing = *sim->capturing;
+    strcpy(snap->fps, sim->fps);
+    strcpy(snap->mspf, sim->mspf);
+    strcpy(snap->audio_time, sim->audio_time);
+    strcpy(snap->audio_late, sim->audio_late);
+    /*publish, and take back whichever slot was waiting; a slot
+     *still marked fresh was never drawn, and its post is still
+     *pending, so only wake the render thread for a new one*/
+    old          = SDL_AtomicSet(&render->middle,
+                                 render->back | SNAPSHOT_FRESH);
+    render->back = old & 0x3;
+    if(!(old & SNAPSHOT_FRESH))
+        SDL_SemPost(render->fresh);
+}
+
+void stop_render_thread(st_shared *shared)
+{
+    int        i;
+    st_render *render = shared->render;
+
+    if(!render)
+        return;
+    if(render->thread)
+    {
+        SDL_AtomicSet(&render->quit, 1);
+        SDL_SemPost(render->fresh);
+        SDL_WaitThread(render->thread, NULL);
+        SDL_GL_MakeCurrent(*shared->win_main, *shared->win_main_gl);
+    }
+    if(render->fresh)
+        SDL_DestroySemaphore(render->fresh);
+    if(render->taken)
+        SDL_DestroySemaphore(render->taken);
+    for(i = 0; i < 3; i++)
+    {
+        free(render->snap[i].aster);
+        free(render->snap[i].plyr);
+        free(render->snap[i].particles.x);
+    }
+    free(render);
+    shared->render = NULL;
+}
@@ -0,0 +1,71 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+#include "shared.h"
+
+/* Move drawing to its own thread.
+ *
+ *     shared - struct containing variables required for drawing
+ *
+ * Allocates the snapshot triple buffer, hands the GL context over
+ * to a new thread, and sets shared->render. From then on the main
+ * thread must not touch GL, and only publishes snapshots with
+ * publish_snapshot(). Should be called once init_gl() is done.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ * On failure the context stays current on the calling thread.
+ **/
+bool start_render_thread    (st_shared *shared);
+
+/* Hand the current game state to the render thread.
+ *
+ *     sim - struct containing variables required for the snapshot
+ *
+ * Copies asteroids, players, and HUD state into the free slot of
+ * the triple buffer and publishes it. Never waits for the render
+ * thread: a snapshot it hasn't taken yet is simply replaced by
+ * the newer one, so the simulation runs at its own pace while
+ * frames are drawn and swapped.
+ **/
+void publish_snapshot       (st_shared *sim);
+
+/* Stop the render thread.
+ *
+ *     shared - struct containing variables required for drawing
+ *
+ * Waits for the thread to finish its frame, makes the GL context
+ * current on the calling thread again, and frees the snapshots.
+ **/
+void stop_render_thread     (st_shared *shared);
+
+#endif /*RENDERTHREAD_H*/
@@ -0,0 +1,248 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifdef _WIN32
+  #include <Windows.h>
+#endif
+#ifdef __APPLE__
+  #include <Carbon/Carbon.h>
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+#include <SDL.h>
+#ifdef _WIN32
+  #include <SDL_opengl_glext.h>
+#endif
+#include <stdio.h>
+#include "glfunc.h"
+#include "glstats.h"
+#include "global.h"
+#include "shared.h"
+#include "glcore.h"
+
+/* Size the framebuffer object to the current scale factor.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * Returns true if the framebuffer object is complete.
+ **/
+bool scale_resize(st_shared *draw)
+{
+    GLenum status;
+
+    draw->scale.width  = (int)(*draw->width_real  * draw->scale.factor);
+    draw->scale.height = (int)(*draw->height_real * draw->scale.factor);
+    if(draw->scale.width < 1)
+        draw->scale.width = 1;
+    if(draw->scale.height < 1)
+        draw->scale.height = 1;
+    glBindTexture(GL_TEXTURE_2D, draw->scale.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, draw->scale.width,
+            draw->scale.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindFramebuffer_ptr(GL_FRAMEBUFFER, draw->scale.fbo);
+    glFramebufferTexture2D_ptr(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D, draw->scale.texture, 0);
+    status = glCheckFramebufferStatus_ptr(GL_FRAMEBUFFER);
+    glBindFramebuffer_ptr(GL_FRAMEBUFFER, 0);
+    return status == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void init_scale(st_shared *init)
+{
+    const float factor = init->config->render_scale;
+
+    init->scale.enabled = false;
+    init->scale.adjust  = factor < SCALE_MIN;
+    init->scale.factor  = init->scale.adjust ? 1.f : factor;
+    init->scale.width   = *init->width_real;
+    init->scale.height  = *init->height_real;
+    init->scale.floor   = SCALE_MIN;
+    init->scale.last    = 0;
+    init->scale.total   = 0.0;
+    init->scale.before  = 0.0;
+    init->scale.frames  = 0;
+    init->scale.steady  = 0;
+    init->scale.trend   = 0;
+    if(!init->scale.adjust && factor > 0.999f) /*full size*/
+        return;
+    if(init->legacy_context)
+    {
+        fprintf(stderr, "Render scale is not available with OpenGL 1.1. Drawing at full size.\n");
+        return;
+    }
+    /*same names in OpenGL 3.0 and ARB_framebuffer_object, the texture
+     *can be any size from OpenGL 2.0 on*/
+    if(init->core_context ||
+            (SDL_GL_ExtensionSupported("GL_ARB_framebuffer_object") &&
+             SDL_GL_ExtensionSupported("GL_ARB_texture_non_power_of_two")))
+    {
+        *(void **) (&glGenFramebuffers_ptr) =
+            SDL_GL_GetProcAddress("glGenFramebuffers");
+        *(void **) (&glBindFramebuffer_ptr) =
+            SDL_GL_GetProcAddress("glBindFramebuffer");
+        *(void **) (&glFramebufferTexture2D_ptr) =
+            SDL_GL_GetProcAddress("glFramebufferTexture2D");
+        *(void **) (&glCheckFramebufferStatus_ptr) =
+            SDL_GL_GetProcAddress("glCheckFramebufferStatus");
+    }
+    if(!glGenFramebuffers_ptr || !glBindFramebuffer_ptr ||
+       !glFramebufferTexture2D_ptr || !glCheckFramebufferStatus_ptr ||
+       (init->core_context && !init_core_scale(init)))
+    {
+        fprintf(stderr, "Framebuffer objects not supported. Drawing at full size.\n");
+        return;
+    }
+    glGenFramebuffers_ptr(1, &init->scale.fbo);
+    glGenTextures(1, &init->scale.texture);
+    glBindTexture(GL_TEXTURE_2D, init->scale.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    if(!scale_resize(init))
+    {
+        fprintf(stderr, "Render scale framebuffer incomplete. Drawing at full size.\n");
+        init->scale.width  = *init->width_real;
+        init->scale.height = *init->height_real;
+        return;
+    }
+    init->scale.enabled = true;
+    if(init->scale.adjust)
+        printf("Render scale: auto, targeting %.1f ms per frame\n",
+                SCALE_TARGET_MS);
+    else
+        printf("Render scale: %.2f (%dx%d)\n", init->scale.factor,
+                init->scale.width, init->scale.height);
+}
+
+/* Pick the next automatic scale factor.
+ *
+ *     draw - struct containing variables required for drawing
+ *     ms   - average frame time of the last SCALE_WINDOW frames
+ *
+ * Steps down when frames are slower than SCALE_TARGET_MS, and up
+ * when they are faster or have been steady for SCALE_PROBE windows,
+ * since vsync hides spare time. If a step down didn't make frames
+ * faster, the stretch costs more than it saves (llvmpipe fills a
+ * textured quad slowly), so that step is undone and never tried again.
+ **/
+void scale_adjust(st_shared *draw, const double ms)
+{
+    float     factor;
+    st_scale *scale = &draw->scale;
+
+    factor = scale->factor;
+    scale->steady++;
+    if(scale->trend < 0 && ms > scale->before*0.95)
+    {
+        factor += SCALE_STEP;
+        scale->floor = factor;
+    }
+    else if(ms > SCALE_TARGET_MS*1.15 && factor - SCALE_STEP > scale->floor - 0.001f)
+        factor -= SCALE_STEP;
+    else if(ms < SCALE_TARGET_MS*0.85 || scale->steady >= SCALE_PROBE)
+        factor += SCALE_STEP;
+    if(factor < SCALE_MIN)
+        factor = SCALE_MIN;
+    if(factor > 1.f)
+        factor = 1.f;
+    scale->trend = 0;
+    if(factor < scale->factor - 0.001f)
+        scale->trend = -1;
+    else if(factor > scale->factor + 0.001f)
+        scale->trend = 1;
+    else
+        return;
+    scale->before = ms;
+    scale->factor = factor;
+    scale->steady = 0;
+    scale_resize(draw);
+}
+
+void scale_begin(st_shared *draw)
+{
+    Uint64    now;
+    Uint64    freq;
+    double    ms;
+    st_scale *scale = &draw->scale;
+
+    if(!scale->enabled)
+        return;
+    if(scale->adjust)
+    {
+        now  = SDL_GetPerformanceCounter();
+        freq = SDL_GetPerformanceFrequency();
+        ms   = (double)(now - scale->last) * 1000.0 / (double)freq;
+        /*skip the first frame and anything after a long stall or idle*/
+        if(scale->last && ms < 250.0)
+        {
+            scale->total += ms;
+            scale->frames++;
+        }
+        scale->last = now;
+        if(scale->frames >= SCALE_WINDOW)
+        {
+            scale_adjust(draw, scale->total / scale->frames);
+            scale->total  = 0.0;
+            scale->frames = 0;
+        }
+    }
+    if(scale->factor < 0.999f) /*full size skips the stretch*/
+        glBindFramebuffer_ptr(GL_FRAMEBUFFER, scale->fbo);
+}
+
+void scale_end(st_shared *draw)
+{
+    if(!draw->scale.enabled || draw->scale.factor > 0.999f)
+        return;
+    glBindFramebuffer_ptr(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, *draw->width_real, *draw->height_real);
+    if(draw->core_context)
+    {
+        draw_core_scale(draw);
+        return;
+    }
+    /*draw_world() left the clip rect projection and an identity
+     *modelview, so the quad is just the clip rect*/
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, draw->scale.texture);
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.f, 0.f);
+    glVertex2f(*draw->left_clip,  *draw->bottom_clip);
+    glTexCoord2f(1.f, 0.f);
+    glVertex2f(*draw->right_clip, *draw->bottom_clip);
+    glTexCoord2f(1.f, 1.f);
+    glVertex2f(*draw->right_clip, *draw->top_clip);
+    glTexCoord2f(0.f, 1.f);
+    glVertex2f(*draw->left_clip,  *draw->top_clip);
+    glEnd();
+    glDisable(GL_TEXTURE_2D);
+}
@@ -0,0 +1,73 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef SCALE_H
+#define SCALE_H
+
+#include "shared.h"
+
+/* Set up the render scale.
+ *
+ *     init - struct containing variables required for init
+ *
+ * With a render scale below 1 (or 'auto'), the scene is drawn into a
+ * framebuffer object that is a fraction of width_real by height_real,
+ * then stretched to the window. Needs OpenGL 3.0, or
+ * ARB_framebuffer_object with ARB_texture_non_power_of_two, and
+ * isn't used by the legacy renderer.
+ * Otherwise, or at scale 1, scenes are drawn straight to the window.
+ * Either way, init->scale holds the size that scenes are drawn at.
+ **/
+void init_scale             (st_shared *init);
+
+/* Start drawing a scaled scene.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * Binds the framebuffer object, if there is one and the scale is
+ * below 1. With 'auto', this also measures the time since the last
+ * frame, and every SCALE_WINDOW frames may move the scale one
+ * SCALE_STEP toward SCALE_TARGET_MS. The scene sets its viewport
+ * from draw->scale.width and height.
+ **/
+void scale_begin            (st_shared *draw);
+
+/* Finish drawing a scaled scene.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * Binds the window with a full size viewport and stretches the
+ * framebuffer object's texture over it with linear filtering, so the
+ * HUD drawn afterwards stays sharp. A textured quad is used rather
+ * than glBlitFramebuffer, which llvmpipe does on a slow path.
+ **/
+void scale_end              (st_shared *draw);
+
+#endif /*SCALE_H*/
@@ -31,19 +31,22 @@
 #ifndef SHARED_H
 #define SHARED_H
 
+#include <stdio.h>
 #include "readconfig.h"
 
 /*** asteroid object ***
  *
- * Each asteroid is a line loop with a non-convex shape.
- * To get even remotely accurate bounds detection, each
- * asteroid is divided into 6 triangles.
+ * Each asteroid is a line loop with a non-convex shape,
+ * one of ASTER_VARIANTS in the mesh atlas. To get even
+ * remotely accurate bounds detection, each asteroid is
+ * divided into triangles fanned out from its center.
  * We only calculate physics and draw the asteroid if it
  * is spawned.
  **/
 typedef struct asteroid {
     int         is_spawned;
     int         collided; /*ID of colliding asteroid*/
+    int         variant;  /*shape, drawn with mesh MESH_ASTER + variant*/
     float       mass;
     float       scale;
     float       pos[2];
@@ -51,7 +54,7 @@ typedef struct asteroid {
     float       angle; /*velocity vector direction in degrees*/
     float       rot;   /*current rotation in degrees*/
     float       rot_speed; 
-    float       bounds_real[6][6]; /*bounding triangles*/
+    float       bounds_real[ASTER_EDGES][6]; /*center, point i, point i+1*/
 } asteroid;
 
 /*** projectile object ***/
@@ -80,21 +83,53 @@ typedef struct player {
     float       rot;
     float       bounds[6];   /*bounding triangle A(x,y) B(x,y) C(x,y)*/
     float       blast_scale; /*blast effect grows until a certain size*/
+    float       exhaust;     /*exhaust particles owed, below 1*/
     projectile  shot;
 } player;
 
-/*** SFX channel ***
+/*** mesh atlas ***
  *
- * An array of st_audio represents different audio channels
- * that get mixed together. Each st_audio contains
- * everything needed to synthesize a sound. If 'silence'
- * is true, only zeros get written to audio. Only the
- * 'volume' from the first st_audio is used to control
- * audio. All variables should be set before playing a sound.
+ * Every shape packed into one vertex and one index array, built
+ * once by init_atlas(). A mesh is a range of the index array,
+ * drawn with its own primitive. See the MESH_* defines.
+ **/
+typedef struct st_mesh {
+    unsigned        mode;  /*GL_LINES, GL_LINE_LOOP or GL_LINE_STRIP*/
+    unsigned        first; /*first index*/
+    unsigned        count; /*number of indices*/
+} st_mesh;
+
+typedef struct st_atlas {
+    int             vert_count;
+    int             index_count;
+    float          *verts; /*x,y pairs*/
+    unsigned short *index;
+    st_mesh         mesh[MESH_COUNT];
+    float           aster_bounds[ASTER_VARIANTS][ASTER_EDGES][6];
+} st_atlas;
+
+/*** particle pool ***
+ *
+ * One array per field, so updates run down each array in turn.
+ * Live particles are packed at the front; see particles.h.
+ **/
+typedef struct st_particles {
+    int         count;    /*live particles*/
+    float      *x;
+    float      *y;
+    float      *vx;       /*per 60 Hz frame*/
+    float      *vy;
+    float      *life;     /*frames left*/
+} st_particles;
+
+/*** SFX synthesizer ***
+ *
+ * Everything needed to synthesize a sound. Sounds are only
+ * synthesized once, into the mixer's cache (see cache_sounds());
+ * 'silence' is set when the sound has ended.
  **/
 typedef struct st_audio {
     bool        silence;
-    int         volume;   /*between 0 and 127*/
     unsigned    i;        /*general incrementer*/
     unsigned    note_nr;  /*increments the note in a tune*/
     unsigned    sfx_nr;   /*ID of sound to play (see SFX* defines)*/
@@ -106,14 +141,258 @@ typedef struct st_audio {
     float       freq;     /*starting frequency*/
     float       amp;      /*starting amplitude*/
     float       env;      /*starting envelope (0 if attack is >0*/
+    unsigned long phase;  /*32-bit wavetable position, kept between calls*/
 } st_audio;
 
+/*** sound recipe ***
+ *
+ * Everything needed to start synthesizing a sound.
+ * See the SOUND_* defines.
+ **/
+typedef struct st_sound {
+    unsigned    sfx_nr;   /*ID of sound to play (see SFX* defines)*/
+    unsigned    waveform; /*1 = square, 2 = saw, 3 = tri, * = sine*/
+    unsigned    attack;   /*ADSR length in samples at AUDIO_RATE_MIN*/
+    unsigned    decay;
+    unsigned    sustain;
+    unsigned    release;
+    float       amp;      /*starting amplitude*/
+    float       env;      /*starting envelope (0 if attack is >0*/
+} st_sound;
+
+/*** cached sound ***/
+typedef struct st_pcm {
+    int         count;    /*samples*/
+    float      *samples;  /*mono, at the mixer rate*/
+} st_pcm;
+
+/*** mix channel ***
+ *
+ * A cached sound being played. 'pcm' points at the next
+ * sample, and is NULL when the channel is free. A channel
+ * waiting out 'delay' is still busy.
+ **/
+typedef struct st_voice {
+    const float *pcm;
+    int          left;     /*samples still to play*/
+    int          delay;    /*samples of silence before the sound*/
+    int          priority; /*see sound_priority[]*/
+    unsigned long order;   /*when the sound started, for stealing*/
+} st_voice;
+
+/*** audio callback timing ***
+ *
+ * Written only by audio_fill_buffer() and read from any thread,
+ * so the counts are atomics and nothing takes a lock. Times are
+ * in microseconds. A callback is late when it starts more than
+ * one and a half buffers after the previous one, and each whole
+ * buffer past the first in that gap counts as missed.
+ **/
+typedef struct st_audio_timing {
+    SDL_atomic_t hist[AUDIO_HIST_BINS]; /*calls by run time*/
+    SDL_atomic_t calls;
+    SDL_atomic_t budget; /*play time of the last buffer*/
+    SDL_atomic_t worst;  /*longest run*/
+    SDL_atomic_t over;   /*runs longer than their buffer plays*/
+    SDL_atomic_t gap;    /*longest time between two calls*/
+    SDL_atomic_t late;
+    SDL_atomic_t missed;
+    Uint64       last;   /*start of the last call, audio thread only*/
+    Uint64       freq;   /*performance counter ticks per second*/
+} st_audio_timing;
+
+/*** audio mixer ***
+ *
+ * Only the audio callback touches 'voice'. The game thread
+ * asks for sounds through 'queue', a single-producer,
+ * single-consumer ring: play_sound() fills queue[head] and
+ * then moves 'head', and the callback starts every sound up
+ * to 'head' and then moves 'tail'. Neither side ever waits.
+ *
+ * Every SOUND_* is synthesized into 'cache' before the device
+ * opens, with several takes of sounds that use rand(). Channels
+ * are mixed as floats at 'rate', then converted to the device
+ * 'format' (see mixer_format()). Every callback is timed into
+ * 'timing'.
+ **/
+typedef struct st_mixer {
+    st_voice     voice[AUDIO_VOICE_MAX];
+    int          voice_count; /*channels in use, the pool size*/
+    int          queue[AUDIO_QUEUE]; /*SOUND_* IDs*/
+    SDL_atomic_t head;    /*next queue slot to fill, game thread*/
+    SDL_atomic_t tail;    /*next queue slot to start, audio thread*/
+    SDL_atomic_t volume;  /*between 0 and 127*/
+    st_pcm       cache[SOUND_COUNT][SOUND_VARIANTS];
+    int          variants[SOUND_COUNT]; /*takes cached of each sound*/
+    int          next_variant[SOUND_COUNT];
+    unsigned long clock;      /*samples mixed so far*/
+    unsigned long started;    /*sounds started so far*/
+    unsigned long next_start[SOUND_COUNT]; /*see sound_gap[]*/
+    int          rate;        /*output sample rate*/
+    int          tick_frames; /*samples per sound tick at 'rate'*/
+    int          frame_bytes; /*bytes per sample in 'format'*/
+    SDL_AudioFormat format;
+    float        out[AUDIO_TICK_MAX];     /*all channels*/
+    short        pcm[AUDIO_TICK_MAX];     /*AUDIO_S16SYS output*/
+    st_audio_timing timing;
+} st_mixer;
+
+/*** cached text ***
+ *
+ * A string along with its glyphs as GL_LINES vertices.
+ * The vertices are only rebuilt when the string changes,
+ * and drawing it takes a single call. 'buffer' is the
+ * VBO holding the vertices, 0 if there isn't one yet.
+ **/
+typedef struct st_text {
+    bool        value_set; /*'value' holds the last number shown*/
+    bool        dirty;     /*vertices changed since the last upload*/
+    unsigned    value;
+    unsigned    buffer;
+    int         vert_count;
+    char        str[TEXT_MAX_CHARS];
+    float       verts[TEXT_MAX_CHARS*24]; /*max 6 lines per glyph*/
+} st_text;
+
+/*** streaming buffer ***
+ *
+ * A ring over one buffer object, for vertex data that changes
+ * every frame. Each write goes after the previous one. Once the
+ * buffer is full its storage is orphaned and writing starts over
+ * at 0, so a range is never overwritten while the GPU may still
+ * be reading it.
+ **/
+typedef struct st_stream {
+    bool        map_range; /*write through glMapBufferRange*/
+    unsigned    buffer;
+    unsigned    target;    /*GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER*/
+    unsigned    size;      /*bytes*/
+    unsigned    offset;    /*next free byte*/
+} st_stream;
+
+/*** render scale ***
+ *
+ * Scenes are drawn at width by height, into 'fbo' when enabled,
+ * otherwise straight to the window at full size. See scale.h.
+ **/
+typedef struct st_scale {
+    bool        enabled;
+    bool        adjust;    /*pick 'factor' from measured frame times*/
+    float       factor;    /*fraction of width_real and height_real*/
+    float       floor;     /*lowest factor 'adjust' may pick*/
+    int         width;
+    int         height;
+    unsigned    fbo;
+    unsigned    texture;   /*color attachment of 'fbo'*/
+    unsigned    program;   /*core renderer stretch shader*/
+    unsigned    scene;     /*core renderer program to go back to*/
+    Uint64      last;      /*performance counter at the last frame*/
+    double      total;     /*ms measured in this window*/
+    double      before;    /*average ms of the window before the change*/
+    unsigned    frames;    /*frames measured in this window*/
+    unsigned    steady;    /*windows since 'factor' last changed*/
+    int         trend;     /*-1 or 1 if the last window changed 'factor'*/
+} st_scale;
+
+/*** simulation snapshot ***
+ *
+ * Everything draw_objects() reads that changes while the game
+ * runs, copied out of the simulation once per frame.
+ **/
+typedef struct st_snapshot {
+    bool        paused;
+    bool        show_fps;
+    bool        capturing;
+    char        fps[32];
+    char        mspf[32];
+    char        audio_time[32];
+    char        audio_late[32];
+    player     *plyr;
+    asteroid   *aster;
+    st_particles particles; /*positions only*/
+} st_snapshot;
+
+/*** render thread ***
+ *
+ * The simulation and the render thread trade snapshots through
+ * a triple buffer. Each side owns one slot ('back' and 'front'),
+ * and 'middle' holds the last published slot, swapped atomically
+ * with SNAPSHOT_FRESH set until the render thread takes it. The
+ * simulation never waits; 'fresh' only wakes the render thread,
+ * and 'taken' is only used when the thread starts.
+ **/
+typedef struct st_render {
+    SDL_Thread *thread;
+    SDL_sem    *fresh;     /*posted when a snapshot is published*/
+    SDL_sem    *taken;     /*posted once the render thread is ready*/
+    SDL_atomic_t middle;
+    SDL_atomic_t quit;
+    int         back;
+    int         front;
+    st_snapshot snap[3];
+} st_render;
+
+/*** video capture ***
+ *
+ * Frames are read into a ring of CAPTURE_PBOS pixel buffer
+ * objects and copied out once the GPU is done with them, a few
+ * frames later. They then go through a queue to the encoder
+ * thread. If the queue is full the frame is dropped instead of
+ * waiting on the encoder.
+ **/
+typedef struct st_capture {
+    bool        pbo;      /*false = synchronous glReadPixels*/
+    bool        failed;   /*couldn't start, wait for a new request*/
+    int         width;
+    int         height;
+    unsigned    buffers[CAPTURE_PBOS];
+    unsigned    frames;   /*frames read back*/
+    unsigned    dropped;
+    Uint64      first;    /*performance counter at the first frame*/
+    Uint64      last;     /*and at the latest one*/
+    int         tail;     /*next queue slot for the encoder*/
+    FILE       *file;     /*NULL unless recording*/
+    SDL_Thread *thread;
+    SDL_sem    *queued;   /*frames waiting to be encoded*/
+    SDL_sem    *free;     /*queue slots that can be filled*/
+    SDL_atomic_t head;    /*next queue slot to fill*/
+    SDL_atomic_t quit;
+    unsigned char *queue[CAPTURE_QUEUE]; /*RGBA, bottom row first*/
+    unsigned char *yuv;   /*encoder output, one 4:2:0 frame*/
+} st_capture;
+
+/*** software framebuffer ***
+ *
+ * One byte of brightness per pixel, top row first. Everything
+ * is drawn white on black, so there is no need for color.
+ **/
+typedef struct st_soft {
+    int            width;
+    int            height;
+    unsigned char *pixels;
+} st_soft;
+
+/*** offscreen benchmark ***
+ *
+ * Frame times in milliseconds, measured from the start of
+ * drawing until the GPU has finished the frame.
+ **/
+typedef struct st_bench {
+    unsigned    frames;    /*frames measured so far*/
+    Uint64      start;     /*performance counter at frame start*/
+    double      total;
+    double      min;
+    double      max;
+} st_bench;
+
 /*** shared pointers ***/
 typedef struct st_shared {
     options        *config;
-    st_audio       *sfx_main;
+    st_mixer       *mixer;
     player        **plyr;
     asteroid      **aster;
+    int           **aster_free;       /*stack of unspawned asteroid IDs*/
+    int            *aster_free_count;
     SDL_Window    **win_main;
     SDL_GLContext  *win_main_gl;
     SDL_AudioDeviceID audio_device;
@@ -131,9 +410,28 @@ typedef struct st_shared {
     float          *frame_time;
     char           *fps;
     char           *mspf;
+    char           *audio_time;     /*audio timing lines, "" if off*/
+    char           *audio_late;
     bool            legacy_context;
+    bool            core_context;
+    int             core_view;      /*clip rect uniform of the core shader*/
+    unsigned        gl_buffers[3];  /*static verts, static indices, stream*/
+    unsigned        gl_lists;       /*legacy display lists, 0 if none*/
+    st_stream       stream;         /*ring over gl_buffers[2]*/
+    st_scale        scale;
+    float          *aster_batch;    /*per-frame asteroid lines or instances*/
+    st_particles   *particles;
+    float          *particle_batch; /*per-frame particle points*/
+    st_text        *hud;            /*see HUD_* defines*/
+    st_render      *render;         /*NULL unless drawing on a thread*/
+    st_capture     *capture;
+    st_soft        *soft;           /*NULL unless using the soft renderer*/
     bool           *paused;
     bool           *show_fps;
+    bool           *capturing;      /*recording wanted, see capture.h*/
+    bool           *minimized;
+    bool           *unfocused;
+    bool           *redraw;         /*an idle frame needs drawing*/
     bool           *loop_exit;
 } st_shared;
 
@@ -0,0 +1,312 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#include <SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mesh.h"
+#include "global.h"
+#include "shared.h"
+#include "softrender.h"
+
+/* Draw a line into the framebuffer.
+ *
+ *     soft - framebuffer to draw into
+ *     x0   - start x in pixels, from the left
+ *     y0   - start y in pixels, from the top
+ *     x1   - end x in pixels
+ *     y1   - end y in pixels
+ *
+ * The line is clipped to the framebuffer (Liang-Barsky), then
+ * stepped one pixel at a time along its major axis with 16.16
+ * fixed point (DDA). The inner loop has no branches, so every
+ * step costs the same.
+ **/
+void soft_line(st_soft *soft, float x0, float y0, float x1, float y1)
+{
+    int         i,steps;
+    long        x,y,sx,sy;
+    float       t0 = 0.f, t1 = 1.f;
+    float       p[4], q[4], r;
+    float       adx, ady;
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    const float xmax = (float)soft->width  - 0.001f;
+    const float ymax = (float)soft->height - 0.001f;
+
+    p[0] = -dx; q[0] = x0;
+    p[1] =  dx; q[1] = xmax - x0;
+    p[2] = -dy; q[2] = y0;
+    p[3] =  dy; q[3] = ymax - y0;
+    for(i = 0; i < 4; i++)
+    {
+        if(p[i] < 0.f)      /*entering*/
+        {
+            r = q[i] / p[i];
+            if(r > t1)
+                return;
+            if(r > t0)
+                t0 = r;
+        }
+        else if(p[i] > 0.f) /*leaving*/
+        {
+            r = q[i] / p[i];
+            if(r < t0)
+                return;
+            if(r < t1)
+                t1 = r;
+        }
+        else if(q[i] < 0.f) /*parallel, outside*/
+            return;
+    }
+    x1 = x0 + t1*dx;
+    y1 = y0 + t1*dy;
+    x0 = x0 + t0*dx;
+    y0 = y0 + t0*dy;
+    /*rounding can leave a clipped end just outside the edge*/
+    x0 = x0 < 0.f ? 0.f : (x0 > xmax ? xmax : x0);
+    y0 = y0 < 0.f ? 0.f : (y0 > ymax ? ymax : y0);
+    x1 = x1 < 0.f ? 0.f : (x1 > xmax ? xmax : x1);
+    y1 = y1 < 0.f ? 0.f : (y1 > ymax ? ymax : y1);
+    adx = x1 > x0 ? x1 - x0 : x0 - x1;
+    ady = y1 > y0 ? y1 - y0 : y0 - y1;
+    steps = (int)(adx > ady ? adx : ady);
+    x  = (long)(x0 * 65536.f);
+    y  = (long)(y0 * 65536.f);
+    sx = steps ? (long)((x1 - x0) * 65536.f) / steps : 0;
+    sy = steps ? (long)((y1 - y0) * 65536.f) / steps : 0;
+    for(i = 0; i <= steps; i++, x += sx, y += sy)
+        soft->pixels[(y >> 16)*soft->width + (x >> 16)] = 0xFF;
+}
+
+/* Draw a mesh from mesh_atlas.
+ *
+ *     draw  - struct containing variables required for drawing
+ *     shape - mesh ID (see MESH_* defines)
+ *     loop  - true for a line loop, false for separate lines
+ *     x     - position
+ *     y
+ *     scale - size modifier
+ *     rot   - rotation in degrees
+ *
+ * Vertices are rotated, scaled, and translated (same order as
+ * get_real_point_pos()), then mapped from the clip rect to pixels.
+ **/
+void soft_shape(st_shared  *draw,
+                const int   shape,
+                const bool  loop,
+                const float x,
+                const float y,
+                const float scale,
+                const float rot)
+{
+    int                   i;
+    const st_mesh        *m       = &mesh_atlas.mesh[shape];
+    const int             count   = m->count;
+    const unsigned short *index   = &mesh_atlas.index[m->first];
+    const float           rad_mod = M_PI/180.f;
+    const float           c  = cos(rot*rad_mod) * scale;
+    const float           s  = sin(rot*rad_mod) * scale;
+    const float           sx = draw->soft->width /
+                               (*draw->right_clip - *draw->left_clip);
+    const float           sy = draw->soft->height /
+                               (*draw->top_clip - *draw->bottom_clip);
+    float                 point[32][2];
+    const float          *v;
+
+    for(i = 0; i < count && i < 32; i++)
+    {
+        v = &mesh_atlas.verts[index[i]*2];
+        point[i][0] = ( v[0]*c + v[1]*s + x - *draw->left_clip) * sx;
+        point[i][1] = (*draw->top_clip - (-v[0]*s + v[1]*c + y)) * sy;
+    }
+    if(loop)
+    {
+        for(i = 0; i < count && i < 32; i++)
+            soft_line(draw->soft, point[i][0], point[i][1],
+                      point[(i+1) % count][0], point[(i+1) % count][1]);
+    }
+    else
+    {
+        for(i = 1; i < count && i < 32; i += 2)
+            soft_line(draw->soft, point[i-1][0], point[i-1][1],
+                      point[i][0], point[i][1]);
+    }
+}
+
+/* Draw the particles as 2x2 pixel points.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * Points are mapped like soft_shape() vertices, and any that
+ * fall off the framebuffer are skipped.
+ **/
+void soft_particles(st_shared *draw)
+{
+    int                 i;
+    int                 px, py;
+    const st_particles *p    = draw->particles;
+    st_soft            *soft = draw->soft;
+    const float         sx   = soft->width /
+                               (*draw->right_clip - *draw->left_clip);
+    const float         sy   = soft->height /
+                               (*draw->top_clip - *draw->bottom_clip);
+    unsigned char      *row;
+
+    for(i = 0; i < p->count; i++)
+    {
+        px = (int)((p->x[i] - *draw->left_clip) * sx);
+        py = (int)((*draw->top_clip - p->y[i]) * sy);
+        if(px < 0 || py < 0 || px >= soft->width-1 || py >= soft->height-1)
+            continue;
+        row = &soft->pixels[py*soft->width + px];
+        row[0] = row[1] = 0xFF;
+        row[soft->width] = row[soft->width+1] = 0xFF;
+    }
+}
+
+bool init_soft(st_shared *init)
+{
+    st_soft *soft;
+
+    soft = (st_soft*) malloc(sizeof(st_soft));
+    if(!soft)
+        return false;
+    soft->width  = *init->width_real;
+    soft->height = *init->height_real;
+    soft->pixels = (unsigned char*) calloc((size_t)soft->width*soft->height,
+                                           1);
+    if(!soft->pixels)
+    {
+        free(soft);
+        return false;
+    }
+    init->soft = soft;
+    /*HUD strings, built on first draw*/
+    init->hud  = (st_text*) calloc(HUD_TEXT_COUNT, sizeof(st_text));
+    return init->hud != NULL;
+}
+
+void draw_soft_objects(st_shared *draw)
+{
+    int         i;
+    const float rad_mod = M_PI/180.f;
+    float       c,s;
+    player     *p;
+    asteroid   *a;
+
+    memset(draw->soft->pixels, 0,
+            (size_t)draw->soft->width*draw->soft->height);
+    soft_particles(draw);
+    for(i = 0; i < (*draw->config).aster_max_count; i++)
+    {
+        a = &(*draw->aster)[i];
+        if(a->is_spawned)
+            soft_shape(draw, MESH_ASTER + a->variant, true,
+                       a->pos[0], a->pos[1], a->scale, a->rot);
+    }
+    for(i = 0; i < (*draw->config).player_count; i++)
+    {
+        p = &(*draw->plyr)[i];
+        if(p->died) /*death effect, second one smaller at 90 degrees*/
+        {
+            soft_shape(draw, MESH_BLAST, false, p->pos[0], p->pos[1],
+                       p->blast_scale, 0.f);
+            soft_shape(draw, MESH_BLAST, false, p->pos[0], p->pos[1],
+                       p->blast_scale*0.5f, 90.f);
+            continue;
+        }
+        soft_shape(draw, MESH_PLAYER, true, p->pos[0], p->pos[1], 1.f, p->rot);
+        if(p->key_shoot && !*draw->paused)
+        {
+            c = cos(p->rot*rad_mod);
+            s = sin(p->rot*rad_mod);
+            soft_shape(draw, MESH_PROJECTILE, false,
+                       p->pos[0] + p->shot.pos[0]*c + p->shot.pos[1]*s,
+                       p->pos[1] - p->shot.pos[0]*s + p->shot.pos[1]*c,
+                       1.f, p->rot);
+        }
+    }
+}
+
+void draw_soft_text(st_shared  *draw,
+                    st_text    *text,
+                    const float x,
+                    const float y,
+                    const float scale)
+{
+    int          i;
+    const float *v  = text->verts;
+    const float  sx = draw->soft->width /
+                      (*draw->right_clip - *draw->left_clip);
+    const float  sy = draw->soft->height /
+                      (*draw->top_clip - *draw->bottom_clip);
+
+    for(i = 0; i+1 < text->vert_count; i += 2, v += 4)
+        soft_line(draw->soft,
+                  (v[0]*scale + x - *draw->left_clip) * sx,
+                  (*draw->top_clip - (v[1]*scale + y)) * sy,
+                  (v[2]*scale + x - *draw->left_clip) * sx,
+                  (*draw->top_clip - (v[3]*scale + y)) * sy);
+}
+
+bool write_ppm(const st_soft *soft, const char *path)
+{
+    int            i,j;
+    unsigned char *row;
+    FILE          *file;
+
+    if(!(file = fopen(path, "wb")))
+    {
+        perror("fopen image file");
+        return false;
+    }
+    if(!(row = (unsigned char*) malloc((size_t)soft->width*3)))
+    {
+        fclose(file);
+        return false;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", soft->width, soft->height);
+    for(i = 0; i < soft->height; i++)
+    {
+        for(j = 0; j < soft->width; j++)
+        {
+            row[j*3]   = soft->pixels[i*soft->width + j];
+            row[j*3+1] = soft->pixels[i*soft->width + j];
+            row[j*3+2] = soft->pixels[i*soft->width + j];
+        }
+        fwrite(row, 3, soft->width, file);
+    }
+    free(row);
+    fclose(file);
+    return true;
+}
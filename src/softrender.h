@@ -0,0 +1,87 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef SOFTRENDER_H
+#define SOFTRENDER_H
+
+#include "shared.h"
+
+/* Set up the software renderer.
+ *
+ *     init - struct containing variables required for init
+ *
+ * Allocates a framebuffer the size of width_real by height_real
+ * and sets init->soft, along with the HUD strings that init_gl()
+ * would otherwise create. No GL context or window is needed.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool init_soft              (st_shared *init);
+
+/* Draw particles, asteroids, players, projectiles, and blasts on the CPU.
+ *
+ *     draw - struct containing variables required for drawing
+ *
+ * Clears the framebuffer, then draws the same mesh_atlas line
+ * geometry as the GL renderers, transformed
+ * the same way. The HUD is left to draw_text().
+ **/
+void draw_soft_objects      (st_shared *draw);
+
+/* Draw a cached text on the CPU.
+ *
+ *     draw  - struct containing variables required for drawing
+ *     text  - cached text to draw
+ *     x     - left edge
+ *     y     - top edge
+ *     scale - glyph size, 1 is 0.04 wide
+ *
+ * Called by draw_text() when using the software renderer.
+ **/
+void draw_soft_text         (st_shared  *draw,
+                             st_text    *text,
+                             const float x,
+                             const float y,
+                             const float scale);
+
+/* Write the framebuffer to a file.
+ *
+ *     soft - framebuffer to write
+ *     path - file to write to
+ *
+ * Writes a binary (P6) PPM image, so output can be compared
+ * against golden images.
+ *
+ * Returns true if operation succeeds, false if an error occurs.
+ **/
+bool write_ppm              (const st_soft *soft,
+                             const char    *path);
+
+#endif /*SOFTRENDER_H*/
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifdef _WIN32
+  #include <Windows.h>
+#endif
+#ifdef __APPLE__
+  #include <Carbon/Carbon.h>
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+#include <SDL.h>
+#include <string.h>
+#include "glfunc.h"
+#include "glstats.h"
+#include "global.h"
+#include "shared.h"
+
+void init_stream(st_stream     *stream,
+                 const unsigned buffer,
+                 const unsigned target,
+                 const unsigned size)
+{
+    stream->map_range = glMapBufferRange_ptr && glUnmapBufferARB_ptr;
+    stream->buffer    = buffer;
+    stream->target    = target;
+    stream->size      = size;
+    stream->offset    = 0;
+    glBindBufferARB_ptr(target, buffer);
+    glBufferDataARB_ptr(target, size, NULL, GL_STREAM_DRAW);
+}
+
+unsigned stream_write(st_stream     *stream,
+                      const void    *data,
+                      const unsigned size)
+{
+    unsigned offset;
+    void    *dst = NULL;
+
+    offset = (stream->offset + STREAM_ALIGN-1) & ~(unsigned)(STREAM_ALIGN-1);
+    glBindBufferARB_ptr(stream->target, stream->buffer);
+    if(offset + size > stream->size) /*full, orphan and start over*/
+    {
+        if(size > stream->size)
+            stream->size = size * STREAM_FRAMES;
+        glBufferDataARB_ptr(stream->target, stream->size, NULL,
+                GL_STREAM_DRAW);
+        offset = 0;
+    }
+    /*nothing in use is written to, so there is no need to sync*/
+    if(stream->map_range)
+        dst = glMapBufferRange_ptr(stream->target, offset, size,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                GL_MAP_UNSYNCHRONIZED_BIT);
+    if(dst)
+    {
+        memcpy(dst, data, size);
+        if(!glUnmapBufferARB_ptr(stream->target)) /*storage was lost*/
+            glBufferSubDataARB_ptr(stream->target, offset, size, data);
+    }
+    else
+        glBufferSubDataARB_ptr(stream->target, offset, size, data);
+    stream->offset = offset + size;
+    return offset;
+}
@@ -0,0 +1,69 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include "shared.h"
+
+/* Set up a streaming buffer.
+ *
+ *     stream - stream to set up
+ *     buffer - buffer object to stream through
+ *     target - GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
+ *     size   - storage size in bytes
+ *
+ * Allocates the storage of 'buffer' once as GL_STREAM_DRAW.
+ * Writes are mapped with glMapBufferRange if it was loaded,
+ * otherwise they go through glBufferSubData.
+ **/
+void init_stream            (st_stream     *stream,
+                             const unsigned buffer,
+                             const unsigned target,
+                             const unsigned size);
+
+/* Write data to a streaming buffer.
+ *
+ *     stream - stream to write to
+ *     data   - data to copy
+ *     size   - size of data in bytes
+ *
+ * Copies 'data' to the next free, STREAM_ALIGN aligned range of
+ * the buffer, which is left bound to its target. If the data
+ * doesn't fit in what is left, the storage is orphaned first,
+ * and grown if the data is bigger than the whole buffer.
+ *
+ * Returns the byte offset of the data in the buffer.
+ **/
+unsigned stream_write       (st_stream     *stream,
+                             const void    *data,
+                             const unsigned size);
+
+#endif /*STREAM_H*/
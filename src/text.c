@@ -0,0 +1,189 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifdef _WIN32
+  #include <Windows.h>
+#endif
+#ifdef __APPLE__
+  #include <Carbon/Carbon.h>
+  #include <OpenGL/gl.h>
+#else
+  #include <GL/gl.h>
+#endif
+#include <SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include "glfunc.h"
+#include "glstats.h"
+#include "global.h"
+#include "mesh.h"
+#include "shared.h"
+#include "softrender.h"
+
+int get_glyph(const char c)
+{
+    if(c == ' ')
+        return MESH_SPACE;
+    else if(c > 0x2F && c < 0x3A) /* 0-9 */
+        return MESH_GLYPH + c - 0x30;
+    else if(c > 0x40 && c < 0x5B) /* A-Z */
+        return MESH_GLYPH + 10 + c - 0x41;
+    else if(c == 0x2E)            /* . */
+        return MESH_PROJECTILE;
+    return -1;
+}
+
+bool set_text(st_text *text, const char *str)
+{
+    int   i,j;
+    int   glyph;
+    int   count;
+    float x,y;
+    float *v;
+    const unsigned short *index;
+
+    if(!strncmp(text->str, str, TEXT_MAX_CHARS-1))
+        return false;
+    strncpy(text->str, str, TEXT_MAX_CHARS-1);
+    text->str[TEXT_MAX_CHARS-1] = '\0';
+    text->value_set  = false;
+    text->dirty      = true;
+    text->vert_count = 0;
+    /*line strips -> line segments, offset by the glyph position*/
+    for(i = 0; text->str[i] != '\0'; i++)
+    {
+        glyph = get_glyph(text->str[i]);
+        if(glyph < 0) /*stop at anything we can't draw*/
+            break;
+        if(glyph == MESH_SPACE)
+            continue;
+        x     = 0.06f*(float)i;
+        y     = glyph == MESH_PROJECTILE ? -0.08f : 0.f;
+        index = &mesh_atlas.index[mesh_atlas.mesh[glyph].first];
+        count = mesh_atlas.mesh[glyph].count;
+        for(j = 0; j < count-1; j++)
+        {
+            v    = &text->verts[text->vert_count*2];
+            v[0] = mesh_atlas.verts[index[j]*2]     + x;
+            v[1] = mesh_atlas.verts[index[j]*2+1]   + y;
+            v[2] = mesh_atlas.verts[index[j+1]*2]   + x;
+            v[3] = mesh_atlas.verts[index[j+1]*2+1] + y;
+            text->vert_count += 2;
+        }
+    }
+    return true;
+}
+
+bool set_text_uint(st_text *text, const char *prefix, const unsigned value)
+{
+    bool rebuilt;
+    char str[TEXT_MAX_CHARS] = {'\0'};
+
+    if(text->value_set && text->value == value)
+        return false;
+    if(strlen(prefix) + 11 > TEXT_MAX_CHARS) /*room for 10 digits*/
+        return false;
+    sprintf(str, "%s%u", prefix, value);
+    rebuilt = set_text(text, str);
+    text->value     = value;
+    text->value_set = true;
+    return rebuilt;
+}
+
+void draw_text(st_shared  *draw,
+               st_text    *text,
+               const float x,
+               const float y,
+               const float scale)
+{
+    int length;
+
+    if(text->vert_count < 1)
+        return;
+    if(draw->soft)
+    {
+        draw_soft_text(draw, text, x, y, scale);
+        return;
+    }
+    if(draw->core_context) /*position and scale as a constant instance*/
+    {
+        glDisableVertexAttribArray_ptr(1);
+        glVertexAttrib4f_ptr(1, x, y, scale, 0.f);
+        if(!text->buffer)
+            glGenBuffersARB_ptr(1, &text->buffer);
+        glBindBufferARB_ptr(GL_ARRAY_BUFFER, text->buffer);
+        if(text->dirty)
+            glBufferDataARB_ptr(GL_ARRAY_BUFFER,
+                    sizeof(float)*2*text->vert_count,
+                    text->verts, GL_STATIC_DRAW);
+        glVertexAttribPointer_ptr(0, 2, GL_FLOAT, GL_FALSE, 0,
+                (void*)(intptr_t)(0));
+        glDrawArrays(GL_LINES, 0, text->vert_count);
+        /*back to the static object buffer*/
+        glBindBufferARB_ptr(GL_ARRAY_BUFFER, draw->gl_buffers[0]);
+        glVertexAttribPointer_ptr(0, 2, GL_FLOAT, GL_FALSE, 0,
+                (void*)(intptr_t)(0));
+        glEnableVertexAttribArray_ptr(1);
+        text->dirty = false;
+        return;
+    }
+    glPushMatrix();
+    glTranslatef(x, y, 0.f);
+    glScalef(scale, scale, 1.f);
+    if(draw->gl_lists) /*one display list per character*/
+    {
+        for(length = 0; text->str[length] != '\0' &&
+                        get_glyph(text->str[length]) >= 0; length++);
+        glCallLists(length, GL_UNSIGNED_BYTE, text->str);
+    }
+    else if(draw->legacy_context)
+    {
+        glVertexPointer(2, GL_FLOAT, 0, text->verts);
+        glDrawArrays(GL_LINES, 0, text->vert_count);
+        glVertexPointer(2, GL_FLOAT, 0, mesh_atlas.verts);
+    }
+    else
+    {
+        if(!text->buffer)
+            glGenBuffersARB_ptr(1, &text->buffer);
+        glBindBufferARB_ptr(GL_ARRAY_BUFFER, text->buffer);
+        if(text->dirty)
+            glBufferDataARB_ptr(GL_ARRAY_BUFFER,
+                    sizeof(float)*2*text->vert_count,
+                    text->verts, GL_STATIC_DRAW);
+        glVertexPointer(2, GL_FLOAT, 0, (void*)(intptr_t)(0));
+        glDrawArrays(GL_LINES, 0, text->vert_count);
+        /*back to the static object buffer*/
+        glBindBufferARB_ptr(GL_ARRAY_BUFFER, draw->gl_buffers[0]);
+        glVertexPointer(2, GL_FLOAT, 0, (void*)(intptr_t)(0));
+    }
+    text->dirty = false;
+    glPopMatrix();
+}
@@ -0,0 +1,95 @@
+/*****************************************************************************
+ * Simple Asteroids
+ * Version 1
+ *
+ * Simple 'Asteroids' clone written in C using SDL2 and OpenGL 1.5
+ *
+ * https://dseguin.github.io/asteroids/
+ * Copyright (c) 2017 David Seguin <davidseguin@live.ca>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ *****************************************************************************/
+
+#ifndef TEXT_H
+#define TEXT_H
+
+#include "shared.h"
+
+/* Get the glyph of a character.
+ *
+ *     c - character to look up
+ *
+ * Returns the mesh ID of the glyph in mesh_atlas, MESH_SPACE
+ * for a space, or -1 if the character can't be drawn. A period
+ * reuses the projectile (MESH_PROJECTILE).
+ **/
+int  get_glyph              (const char  c);
+
+/* Set the string of a cached text.
+ *
+ *     text - cached text to update
+ *     str  - new string
+ *
+ * Glyph vertices are only rebuilt if 'str' differs from the
+ * current string. Digits, capital letters, spaces, and periods
+ * are drawn. The string ends at the first other character.
+ *
+ * Returns true if the vertices were rebuilt.
+ **/
+bool set_text               (st_text    *text,
+                             const char *str);
+
+/* Set a cached text to a label followed by a number.
+ *
+ *     text   - cached text to update
+ *     prefix - label in front of the number
+ *     value  - number to show
+ *
+ * The string is only formatted when 'value' differs from
+ * the last one given, so a steady score costs nothing.
+ *
+ * Returns true if the vertices were rebuilt.
+ **/
+bool set_text_uint          (st_text        *text,
+                             const char     *prefix,
+                             const unsigned  value);
+
+/* Draw a cached text.
+ *
+ *     draw  - struct containing variables required for drawing
+ *     text  - cached text to draw
+ *     x     - left edge
+ *     y     - top edge
+ *     scale - glyph size, 1 is 0.04 wide
+ *
+ * Glyphs are placed 0.06*scale apart. Uploads the vertices to the
+ * text's own buffer object the first time it is drawn after a change.
+ * With the core renderer, position and scale go to the shader as a
+ * constant instance attribute. The legacy renderer calls one display
+ * list per character. The soft renderer draws it on the CPU.
+ **/
+void draw_text              (st_shared  *draw,
+                             st_text    *text,
+                             const float x,
+                             const float y,
+                             const float scale);
+
+#endif /*TEXT_H*/